@@ -16,6 +16,8 @@
 #define ReflectionAttribute_h_
 
 #include "ReflectionImplement.h"
+#include "ReflectionPolicy.h"
+#include <type_traits>
 
 namespace Reflection
 {
@@ -28,18 +30,43 @@ public:
   virtual ReflectionHandle getter(void * self, void * data) = 0;
   virtual ReflectionHandle setter(void * self, void * data,
                                   ReflectionHandle value) = 0;
+  // Getter for values referring into self, they keep owner (the script
+  // object of self) alive
+  virtual ReflectionHandle ownedGetter(void * self, void * data,
+                                       ReflectionHandle owner
+                                         __attribute__((unused)))
+    { return getter(self, data); }
 };
 
+  // For the policies, 0 is the value read and 1 is self
 template<typename T, typename A>
 class Attribute : public AttributeBase
 {
 public:
-  Attribute(A T:: * a) : a_(a) {}
+  Attribute(A T:: * a, const Policies & policies = Policies())
+    : a_(a), policies_(policies)
+    {
+      policies_.check(2);
+    }
 
   virtual ReflectionHandle getter(void * self, void * data) override
     {
       T * selfCasted = (T*)self;
-      return ReflectionRead(*selfCasted.*a_, data);
+      // Pointers are passed on, anything else is read as a reference
+      typedef typename std::conditional<std::is_pointer<A>::value,
+                                        A, A &>::type Result;
+      return ReadWithPolicy<Result>::read(*selfCasted.*a_, policies_, data);
+    }
+  virtual ReflectionHandle ownedGetter(void * self, void * data,
+                                       ReflectionHandle owner) override
+    {
+      ReflectionHandle result = getter(self, data);
+      if (policies_.needsKeepAlive())
+        {
+          ReflectionHandle handles[2] = { result, owner };
+          applyKeepAlive(policies_, handles, 2, data);
+        }
+      return result;
     }
   virtual ReflectionHandle setter(void * self, void * data,
                                   ReflectionHandle value) override
@@ -51,6 +78,47 @@ public:
 
 private:
   A T::* a_;
+  Policies policies_;
+};
+
+  // A vector of numbers, exported without copy where the script language
+  // allows it (see ReflectionReadBuffer)
+template<typename T, typename A>
+class BufferAttribute : public Attribute<T, std::vector<A> >
+{
+public:
+  BufferAttribute(std::vector<A> T:: * a)
+    : Attribute<T, std::vector<A> >(a), a_(a) {}
+
+  virtual ReflectionHandle ownedGetter(void * self, void * data,
+                                       ReflectionHandle owner) override
+    {
+      T * selfCasted = (T*)self;
+      return ReflectionReadBuffer(*selfCasted.*a_, data, owner);
+    }
+
+private:
+  std::vector<A> T::* a_;
+};
+
+  // A vector exported as a lazy view (see ReflectionReadView) : elements are
+  // converted when the script accesses them, not when the attribute is read
+template<typename T, typename A>
+class ViewAttribute : public Attribute<T, std::vector<A> >
+{
+public:
+  ViewAttribute(std::vector<A> T:: * a)
+    : Attribute<T, std::vector<A> >(a), a_(a) {}
+
+  virtual ReflectionHandle ownedGetter(void * self, void * data,
+                                       ReflectionHandle owner) override
+    {
+      T * selfCasted = (T*)self;
+      return ReflectionReadView(*selfCasted.*a_, data, owner);
+    }
+
+private:
+  std::vector<A> T::* a_;
 };
 
 }
@@ -21,14 +21,13 @@
 #include "ReflectionConstructor.h"
 #include "ReflectionEnum.h"
 #include <map>
+#include <type_traits>
 #include <vector>
 
 namespace Reflection
 {
 
-template <typename A1=NoClass, typename A2=NoClass, typename A3=NoClass,
-          typename A4=NoClass, typename A5=NoClass, typename A6=NoClass,
-          typename A7=NoClass>
+template <typename... Args>
 struct init
 {
 };
@@ -42,72 +41,37 @@ public:
   Class(std::string && name);
   virtual std::string getTypeIdName() const override;
   virtual std::string getPointerTypeIdName() const override;
+  virtual TypeId getTypeId() const override;
+  virtual TypeId getPointerTypeId() const override;
 
-  // Define access to a member
+  // Define access to a member.  policies (a ReturnPolicy, keep_alive or a
+  // braced list of them) say how an exported class is handed to the script.
   template<typename A>
-    self & def_a(const std::string & argName, A T:: * a);
+    self & def_a(const std::string & argName, A T:: * a,
+                 const Policies & policies = Policies());
+  // Define access to a vector of numbers, which Python gets as a zero-copy
+  // buffer (memoryview, numpy) instead of a list
+  template<typename A>
+    self & def_buffer(const std::string & argName, std::vector<A> T:: * a);
+  // Define access to a vector which the script sees as a lazy view instead
+  // of a copied array/list.  Meant for large vectors of which scripts only
+  // touch a few elements.
+  template<typename A>
+    self & def_view(const std::string & argName, std::vector<A> T:: * a);
   // Define access to a static method
-  template<typename R>
-    self & def_f(const std::string & methodName, R (*a)());
-  template<typename R, typename A1>
-    self & def_f(const std::string & methodName, R (*a)(A1));
-  template<typename R, typename A1, typename A2>
-    self & def_f(const std::string & methodName, R (*a)(A1, A2));
-  template<typename R, typename A1, typename A2, typename A3>
-    self & def_f(const std::string & methodName, R (*a)(A1, A2, A3));
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4>
-    self & def_f(const std::string & methodName, R (*a)(A1, A2, A3, A4));
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4, typename A5>
-    self & def_f(const std::string & methodName, R (*a)(A1, A2, A3, A4, A5));
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4, typename A5, typename A6>
-    self & def_f(const std::string & methodName, R (*a)(A1, A2, A3, A4, A5,A6));
-
+  template<typename R, typename... Args>
+    self & def_f(const std::string & methodName, R (*a)(Args...),
+                 const Policies & policies = Policies());
   // Define access to a method
-  template<typename R>
-    self & def_f(const std::string & methodName, R (T::*a)());
-  template<typename R, typename A1>
-    self & def_f(const std::string & methodName, R (T::*a)(A1));
-  template<typename R, typename A1, typename A2>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2));
-  template<typename R, typename A1, typename A2, typename A3>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3));
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3, A4));
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4, typename A5>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3, A4, A5));
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4, typename A5, typename A6>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3, A4, A5,
-                                                           A6));
-  template<typename R>
-    self & def_f(const std::string & methodName, R (T::*a)() const);
-  template<typename R, typename A1>
-    self & def_f(const std::string & methodName, R (T::*a)(A1) const);
-  template<typename R, typename A1, typename A2>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2) const);
-  template<typename R, typename A1, typename A2, typename A3>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3) const);
-  template<typename R, typename A1, typename A2, typename A3, typename A4>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3,
-                                                           A4) const);
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4, typename A5>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3,
-                                                           A4, A5) const);
-  template<typename R, typename A1, typename A2, typename A3,
-           typename A4, typename A5, typename A6>
-    self & def_f(const std::string & methodName, R (T::*a)(A1, A2, A3,
-                                                           A4, A5, A6) const);
+  template<typename R, typename... Args>
+    self & def_f(const std::string & methodName, R (T::*a)(Args...),
+                 const Policies & policies = Policies());
+  template<typename R, typename... Args>
+    self & def_f(const std::string & methodName, R (T::*a)(Args...) const,
+                 const Policies & policies = Policies());
   // Define a constructor
-  template<typename A1, typename A2, typename A3,
-           typename A4, typename A5, typename A6,
-           typename A7>
-  self & def_c(const init<A1,A2,A3,A4,A5,A6,A7> & i);
+  template<typename... Args>
+  self & def_c(const init<Args...> & i);
 
   // Define an enum
   template<typename E1>
@@ -135,216 +99,86 @@ std::string Class<T>::getPointerTypeIdName() const
 }
 
 template<typename T>
-template<typename A>
-Class<T> & Class<T>::def_a(const std::string & argName, A T:: * a)
-{
-  (*attributeMap_)[argName] = new Attribute<T, A>(a);
-  return *this;
-}
-
-template<typename T>
-template<typename R>
-Class<T> & Class<T>::def_f(const std::string & methodName, R (*a)())
-{
-  (*methodMap_).insert({methodName, new Function<R>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1>
-Class<T> & Class<T>::def_f(const std::string & methodName, R (*a)(A1))
-{
-  (*methodMap_).insert({methodName, new Function<R, A1>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (*a)(A1,A2))
-{
-  (*methodMap_).insert({methodName, new Function<R, A1, A2>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (*a)(A1,A2,A3))
-{
-  (*methodMap_).insert({methodName, new Function<R, A1, A2, A3>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (*a)(A1,A2,A3,A4))
-{
-  (*methodMap_).insert({methodName, new Function<R,A1,A2,A3,A4>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4,
-         typename A5>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (*a)(A1,A2,A3,A4,A5))
-{
-  (*methodMap_).insert({methodName, new Function<R, A1,A2,A3,A4,A5>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4,
-         typename A5, typename A6>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (*a)(A1,A2,A3,A4,A5,A6))
-{
-  (*methodMap_).insert({methodName, new Function<R, A1, A2, A3, A4,
-                                                 A5, A6>((void*)a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)())
-{
-  (*methodMap_).insert({methodName, new Method<T, R>(a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1))
-{
-  (*methodMap_).insert({methodName, new Method<T, R, A1>(a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2))
-{
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2>(a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3))
-{
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3>(a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3, A4))
-{
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3, A4>(a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4,
-         typename A5>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3, A4, A5))
-{
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3, A4, A5>(a)});
-  return *this;
-}
-
-template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4,
-         typename A5, typename A6>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3, A4, A5, A6))
+TypeId Class<T>::getTypeId() const
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3, A4,A5,A6>(a)});
-  return *this;
+  return TypeIdOf<T>::id();
 }
 
 template<typename T>
-template<typename R>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)() const)
+TypeId Class<T>::getPointerTypeId() const
 {
-  (*methodMap_).insert({methodName, new Method<T, R>(a)});
-  return *this;
+  return TypeIdOf<T*>::id();
 }
 
 template<typename T>
-template<typename R, typename A1>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1) const)
+template<typename A>
+Class<T> & Class<T>::def_a(const std::string & argName, A T:: * a,
+                           const Policies & policies)
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1>(a)});
+  (*attributeMap_)[argName] = new Attribute<T, A>(a, policies);
   return *this;
 }
 
 template<typename T>
-template<typename R, typename A1, typename A2>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2) const)
+template<typename A>
+Class<T> & Class<T>::def_buffer(const std::string & argName,
+                                std::vector<A> T:: * a)
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2>(a)});
+  static_assert(std::is_arithmetic<A>::value && !std::is_same<A, bool>::value,
+                "def_buffer needs a vector of numbers");
+  (*attributeMap_)[argName] = new BufferAttribute<T, A>(a);
   return *this;
 }
 
 template<typename T>
-template<typename R, typename A1, typename A2, typename A3>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3) const)
+template<typename A>
+Class<T> & Class<T>::def_view(const std::string & argName,
+                              std::vector<A> T:: * a)
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3>(a)});
+  (*attributeMap_)[argName] = new ViewAttribute<T, A>(a);
   return *this;
 }
 
 template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4>
-Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3, A4) const)
+template<typename R, typename... Args>
+Class<T> & Class<T>::def_f(const std::string & methodName, R (*a)(Args...),
+                           const Policies & policies)
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3, A4>(a)});
+  auto method = new Function<R, Args...>(a);
+  method->setPolicies(policies);
+  (*methodMap_).insert({methodName, method});
   return *this;
 }
 
 template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4,
-         typename A5>
+template<typename R, typename... Args>
 Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3, A4, A5) const)
+                           R (T::*a)(Args...),
+                           const Policies & policies)
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3, A4, A5>(a)});
+  auto method = new Method<decltype(a)>(a);
+  method->setPolicies(policies);
+  (*methodMap_).insert({methodName, method});
   return *this;
 }
 
 template<typename T>
-template<typename R, typename A1, typename A2, typename A3, typename A4,
-         typename A5, typename A6>
+template<typename R, typename... Args>
 Class<T> & Class<T>::def_f(const std::string & methodName,
-                           R (T::*a)(A1, A2, A3, A4, A5, A6) const)
+                           R (T::*a)(Args...) const,
+                           const Policies & policies)
 {
-  (*methodMap_).insert({methodName, new Method<T, R, A1, A2, A3, A4,A5,A6>(a)});
+  auto method = new Method<decltype(a)>(a);
+  method->setPolicies(policies);
+  (*methodMap_).insert({methodName, method});
   return *this;
 }
 
 template<typename T>
-template<typename A1, typename A2, typename A3,
-         typename A4, typename A5, typename A6,
-         typename A7>
-Class<T> & Class<T>::def_c(const init<A1,A2,A3,A4,A5,A6,A7> & i
-                           __attribute__((unused)))
+template<typename... Args>
+Class<T> & Class<T>::def_c(const init<Args...> & i __attribute__((unused)))
 {
-  Class<T>::constructorArray_->
-    push_back(new Constructor<T,A1,A2,A3,A4,A5,A6,A7>);
+  Class<T>::constructorArray_->push_back(new Constructor<T, Args...>);
   return *this;
 }
 
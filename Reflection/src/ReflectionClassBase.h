@@ -15,6 +15,7 @@
 #ifndef ReflectionClassBase_h_
 #define ReflectionClassBase_h_
 
+#include "ReflectionTypeId.h"
 #include <vector>
 #include <unordered_map>
 #include <string>
@@ -29,11 +30,17 @@ class MethodBase;
 class ConstructorBase;
 class EnumBase;
 
+  // Converts a pointer to a derived class into a pointer to one of its base
+  // classes, see Reflection::upcast
+typedef void * (*Upcast)(void * object);
+
 class ClassBase
 {
 public:
   typedef std::unordered_map<std::string, AttributeBase*> AttributeMap;
   typedef std::unordered_multimap<std::string, MethodBase*> MethodMap;
+  typedef std::vector<MethodBase*> MethodArray;
+  typedef std::unordered_map<std::string, MethodArray> FlatMethodMap;
   typedef std::vector<ConstructorBase*> ConstructorArray;
   typedef std::vector<EnumBase*> EnumArray;
 
@@ -47,12 +54,22 @@ public:
   std::string getName() const;
   virtual std::string getTypeIdName() const = 0;
   virtual std::string getPointerTypeIdName() const = 0;
+  virtual TypeId getTypeId() const = 0;
+  virtual TypeId getPointerTypeId() const = 0;
   ClassBase * getParent1() const;
   ClassBase * getParent2() const;
+  // Converts a pointer to this class into a pointer to parent2, nullptr when
+  // unknown.  parent1 is assumed to start at the same address as this class.
+  Upcast getUpcast2() const { return upcast2_; }
   ReflectionClassInfo * getClassInfo() const;
 
   AttributeMap * getAttributeMap() const { return attributeMap_; }
   MethodMap * getMethodMap() const { return methodMap_; }
+  // All methods callable on this class, per name, in resolution order : own
+  // methods first, then those of parent1 and its bases, then those of parent2
+  // and its bases.  Methods of parent2 convert self with getUpcast2(), they
+  // are left out when it is unknown.  Filled in by Registry::init().
+  const FlatMethodMap * getFlatMethodMap() const { return flatMethodMap_; }
   ConstructorArray * getConstructorArray() const { return constructorArray_; }
   EnumArray * getEnumArray() const { return enumArray_; }
 
@@ -60,16 +77,20 @@ protected:
   std::string name_;
   ClassBase * parent1_;
   ClassBase * parent2_;
+  Upcast upcast2_;
   ReflectionClassInfo * classInfo_;
   AttributeMap * attributeMap_;
   MethodMap * methodMap_;
+  FlatMethodMap * flatMethodMap_;
+  MethodArray * upcastMethods_; // owned by flatMethodMap_
   ConstructorArray * constructorArray_;
   EnumArray * enumArray_;
 
 private:
   friend class Registry;
 
-  void addParent(ClassBase * parent);
+  void addParent(ClassBase * parent, Upcast upcast);
+  void flattenMethods();
 };
 
 }
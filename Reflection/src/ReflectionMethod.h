@@ -16,8 +16,15 @@
 #define ReflectionMethod_h_
 
 #include "ReflectionImplement.h"
+#include "ReflectionPolicy.h"
 #include "ReflectionUtil.h"
+#include <algorithm>
+#include <initializer_list>
+#include <memory>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 namespace Reflection
 {
@@ -47,631 +54,268 @@ struct ReferenceArgument<T &>
     }
 };
 
-  // A method of a class
-class MethodBase
+  // How an argument of type Arg is kept during a call : converted into a
+  // value of its unqualified type
+template <typename Arg, typename Enable = void>
+struct ArgumentHolder
 {
-public:
-  MethodBase() : isStatic_(false) {}
-  virtual ReflectionHandle call(void * self, void * data,
-                                ReflectionHandle a1, ReflectionHandle a2,
-                                ReflectionHandle a3, ReflectionHandle a4,
-                                ReflectionHandle a5, ReflectionHandle a6,
-                                ReflectionHandle a7) = 0;
-  unsigned int getNumArgs() const { return numFuncArgs_%8; }
-  bool isStatic() const { return isStatic_; }
-  const std::vector<std::string> & signature() const { return signature_; }
+  typedef typename GetUnQualifiedType<Arg>::BaseType type;
 
-protected:
-  // 0-7 : non-const, 8-15 : const
-  unsigned int numFuncArgs_;
-  bool isStatic_;
-  std::vector<std::string> signature_;
+  static void write(ReflectionHandle handle, type & value, void * data)
+    {
+      ReflectionWrite(handle, value, data);
+    }
+  static type & get(type & value) { return value; }
+  static void update(ReflectionHandle handle, type & value, void * data)
+    {
+      ReferenceArgument<Arg>::convert(handle, value, data);
+    }
+};
+
+  // An exported class passed by (const) reference binds to the object of the
+  // script itself : no copy, and nothing to copy back
+template <typename Arg>
+struct ArgumentHolder<Arg,
+  typename std::enable_if<std::is_reference<Arg>::value &&
+                          std::is_base_of<ScriptAccess,
+                            typename GetUnQualifiedType<Arg>::BaseType>::value
+                         >::type>
+{
+  typedef typename GetUnQualifiedType<Arg>::BaseType Object;
+  typedef Object * type;
+
+  static void write(ReflectionHandle handle, type & value, void * data)
+    {
+      value = ReflectionWrapped<Object>(handle, data);
+      if (value == nullptr)
+        throw std::runtime_error("Conversion from script to C++ failed\n"
+                                 "Got nil from script for a reference type "
+                                 "in C++");
+    }
+  static Object & get(type & value) { return *value; }
+  static void update(ReflectionHandle handle __attribute__((unused)),
+                     type & value __attribute__((unused)),
+                     void * data __attribute__((unused))) {}
 };
 
-// Method with up to 6 arguments returning non-void
-template<typename T, typename R,
-         typename A1=NoClass, typename A2=NoClass, typename A3=NoClass,
-         typename A4=NoClass, typename A5=NoClass, typename A6=NoClass,
-         typename A7=NoClass>
-struct Method : public MethodBase
+  // A unique_ptr is moved into the call
+template <typename T>
+struct ArgumentHolder<std::unique_ptr<T> >
 {
+  typedef std::unique_ptr<T> type;
+
+  static void write(ReflectionHandle handle, type & value, void * data)
+    {
+      ReflectionWrite(handle, value, data);
+    }
+  static type && get(type & value) { return std::move(value); }
+  static void update(ReflectionHandle handle __attribute__((unused)),
+                     type & value __attribute__((unused)),
+                     void * data __attribute__((unused))) {}
+};
+
+  // The script arguments of a call converted to C++, one per argument of the
+  // exported signature
+template <typename... Args>
+class ArgumentPack
+{
+  static_assert(sizeof...(Args) <= maxArguments,
+                "Too many arguments, see Reflection::maxArguments");
 public:
-  Method(R (T::*m)())                            : m0_(m)  { numFuncArgs_ =  0;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1))                          : m1_(m)  { numFuncArgs_ =  1;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2))                      : m2_(m)  { numFuncArgs_ =  2;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3))                  : m3_(m)  { numFuncArgs_ =  3;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4))              : m4_(m)  { numFuncArgs_ =  4;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4, A5))          : m5_(m)  { numFuncArgs_ =  5;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4, A5, A6))      : m6_(m)  { numFuncArgs_ =  6;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4, A5, A6, A7))  : m7_(m)  { numFuncArgs_ =  7;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
+  ArgumentPack(const ReflectionHandle * handles, void * data)
+    : handles_(handles), data_(data)
+    {
+      write(std::index_sequence_for<Args...>());
+    }
 
-  Method(R (T::*m)() const)                      : m0c_(m) { numFuncArgs_ =  8;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1) const)                    : m1c_(m) { numFuncArgs_ =  9;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2) const)                : m2c_(m) { numFuncArgs_ = 10;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3) const)            : m3c_(m) { numFuncArgs_ = 11;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4) const)        : m4c_(m) { numFuncArgs_ = 12;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4, A5) const)    : m5c_(m) { numFuncArgs_ = 13;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4, A5, A6) const): m6c_(m) { numFuncArgs_ = 14;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(R (T::*m)(A1, A2, A3, A4,A5,A6,A7) const): m7c_(m) { numFuncArgs_ = 15;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
+  // Call f with the converted arguments
+  template <typename F>
+  decltype(auto) apply(F && f)
+    {
+      return applyIndexed(f, std::index_sequence_for<Args...>());
+    }
 
-  virtual ReflectionHandle call(void * self,
-                                void * data,
-                                ReflectionHandle a1,
-                                ReflectionHandle a2,
-                                ReflectionHandle a3,
-                                ReflectionHandle a4,
-                                ReflectionHandle a5,
-                                ReflectionHandle a6,
-                                ReflectionHandle a7) override
+  // Copy back arguments passed by non-const reference
+  void update()
     {
-      T * selfCasted = (T*)self;
-      typename GetUnQualifiedType<A1>::BaseType cA1;
-      typename GetUnQualifiedType<A2>::BaseType cA2;
-      typename GetUnQualifiedType<A3>::BaseType cA3;
-      typename GetUnQualifiedType<A4>::BaseType cA4;
-      typename GetUnQualifiedType<A5>::BaseType cA5;
-      typename GetUnQualifiedType<A6>::BaseType cA6;
-      typename GetUnQualifiedType<A7>::BaseType cA7;
-      ReflectionWrite(a1, cA1, data);
-      ReflectionWrite(a2, cA2, data);
-      ReflectionWrite(a3, cA3, data);
-      ReflectionWrite(a4, cA4, data);
-      ReflectionWrite(a5, cA5, data);
-      ReflectionWrite(a6, cA6, data);
-      ReflectionWrite(a7, cA7, data);
-      ReflectionHandle result;
-      switch (numFuncArgs_)
-        {
-        case 0:
-          return ReflectionRead((selfCasted->*m0_)(), data);
-        case 1:
-          result = ReflectionRead((selfCasted->*m1_)(cA1), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          return result;
-        case 2:
-          result = ReflectionRead((selfCasted->*m2_)(cA1, cA2), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          return result;
-        case 3:
-          result = ReflectionRead((selfCasted->*m3_)(cA1, cA2, cA3), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          return result;
-        case 4:
-          result = ReflectionRead((selfCasted->*m4_)(cA1, cA2, cA3, cA4),
-                                  data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          return result;
-        case 5:
-          result = ReflectionRead((selfCasted->*m5_)(cA1, cA2, cA3, cA4,
-                                                     cA5), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          return result;
-        case 6:
-          result = ReflectionRead((selfCasted->*m6_)(cA1, cA2, cA3, cA4,
-                                                     cA5, cA6), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          return result;
-        case 7:
-          result = ReflectionRead((selfCasted->*m7_)(cA1, cA2, cA3, cA4,
-                                                     cA5, cA6, cA7), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          ReferenceArgument<A7>::convert(a7, cA7, data);
-          return result;
-        case 8:
-          return ReflectionRead((selfCasted->*m0c_)(), data);
-        case 9:
-          result = ReflectionRead((selfCasted->*m1c_)(cA1), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          return result;
-        case 10:
-          result = ReflectionRead((selfCasted->*m2c_)(cA1, cA2), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          return result;
-        case 11:
-          result = ReflectionRead((selfCasted->*m3c_)(cA1, cA2, cA3),data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          return result;
-        case 12:
-          result = ReflectionRead((selfCasted->*m4c_)(cA1, cA2, cA3, cA4),
-                                  data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          return result;
-        case 13:
-          result = ReflectionRead((selfCasted->*m5c_)(cA1, cA2, cA3, cA4,
-                                                      cA5), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          return result;
-        case 14:
-          result = ReflectionRead((selfCasted->*m6c_)(cA1, cA2, cA3,cA4,
-                                                      cA5, cA6), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          return result;
-        case 15:
-          result = ReflectionRead((selfCasted->*m7c_)(cA1, cA2, cA3,cA4,
-                                                      cA5, cA6, cA7), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          ReferenceArgument<A7>::convert(a7, cA7, data);
-          return result;
-        default:
-          throw std::runtime_error("Impossible");
-        }
+      updateIndexed(std::index_sequence_for<Args...>());
     }
+
 private:
-  union
+  template <std::size_t... I>
+  void write(std::index_sequence<I...>)
+    {
+      (void)std::initializer_list<int>
+        { 0, (ArgumentHolder<Args>::write(handles_[I], std::get<I>(values_),
+                                          data_), 0)... };
+    }
+
+  template <typename F, std::size_t... I>
+  decltype(auto) applyIndexed(F & f, std::index_sequence<I...>)
     {
-      R (T::*m0_)();
-      R (T::*m1_)(A1);
-      R (T::*m2_)(A1, A2);
-      R (T::*m3_)(A1, A2, A3);
-      R (T::*m4_)(A1, A2, A3, A4);
-      R (T::*m5_)(A1, A2, A3, A4, A5);
-      R (T::*m6_)(A1, A2, A3, A4, A5, A6);
-      R (T::*m7_)(A1, A2, A3, A4, A5, A6, A7);
-      R (T::*m0c_)() const;
-      R (T::*m1c_)(A1) const;
-      R (T::*m2c_)(A1, A2) const;
-      R (T::*m3c_)(A1, A2, A3) const;
-      R (T::*m4c_)(A1, A2, A3, A4) const;
-      R (T::*m5c_)(A1, A2, A3, A4, A5) const;
-      R (T::*m6c_)(A1, A2, A3, A4, A5, A6) const;
-      R (T::*m7c_)(A1, A2, A3, A4, A5, A6, A7) const;
-    };
+      return f(ArgumentHolder<Args>::get(std::get<I>(values_))...);
+    }
+
+  template <std::size_t... I>
+  void updateIndexed(std::index_sequence<I...>)
+    {
+      (void)std::initializer_list<int>
+        { 0, (ArgumentHolder<Args>::update(handles_[I], std::get<I>(values_),
+                                           data_), 0)... };
+    }
+
+  const ReflectionHandle * handles_;
+  void * data_;
+  std::tuple<typename ArgumentHolder<Args>::type...> values_;
 };
 
-// Specialisation for void-returning methods
-template<typename T,
-         typename A1, typename A2, typename A3,
-         typename A4, typename A5, typename A6,
-         typename A7>
-struct Method<T, void, A1, A2, A3, A4, A5, A6, A7> : public MethodBase
+  // Call f with arguments and convert its result
+template <typename R>
+struct CallAndRead
 {
-public:
-  Method(void (T::*m)())                         : m0_(m)  { numFuncArgs_ =  0;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1))                       : m1_(m)  { numFuncArgs_ =  1;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2))                   : m2_(m)  { numFuncArgs_ =  2;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3))               : m3_(m)  { numFuncArgs_ =  3;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3, A4))           : m4_(m)  { numFuncArgs_ =  4;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3, A4, A5))       : m5_(m)  { numFuncArgs_ =  5;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3, A4, A5, A6))   : m6_(m)  { numFuncArgs_ =  6;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3, A4, A5, A6, A7)) : m7_(m)  { numFuncArgs_ = 7;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-
-  Method(void (T::*m)() const)                   : m0c_(m) { numFuncArgs_ =  8;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1) const)                 : m1c_(m) { numFuncArgs_ =  9;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2) const)             : m2c_(m) { numFuncArgs_ = 10;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3) const)         : m3c_(m) { numFuncArgs_ = 11;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3, A4) const)     : m4c_(m) { numFuncArgs_ = 12;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3, A4, A5) const) : m5c_(m) { numFuncArgs_ = 13;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1, A2, A3,A4,A5,A6) const): m6c_(m) { numFuncArgs_ = 14;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
-  Method(void (T::*m)(A1,A2,A3,A4,A5,A6,A7) const): m7c_(m) { numFuncArgs_ = 15;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make(); }
+  template <typename Arguments, typename F>
+  static ReflectionHandle call(Arguments & arguments, F && f,
+                               const Policies & policies, void * data)
+    {
+      ReflectionHandle result =
+        ReadWithPolicy<R>::read(arguments.apply(f), policies, data);
+      arguments.update();
+      return result;
+    }
+};
 
-  virtual ReflectionHandle call(void * self,
-                                void * data,
-                                ReflectionHandle a1,
-                                ReflectionHandle a2,
-                                ReflectionHandle a3,
-                                ReflectionHandle a4,
-                                ReflectionHandle a5,
-                                ReflectionHandle a6,
-                                ReflectionHandle a7) override
+template <>
+struct CallAndRead<void>
+{
+  template <typename Arguments, typename F>
+  static ReflectionHandle call(Arguments & arguments, F && f,
+                               const Policies & policies
+                                 __attribute__((unused)),
+                               void * data)
     {
-      T * selfCasted = (T*)self;
-      typename GetUnQualifiedType<A1>::BaseType cA1;
-      typename GetUnQualifiedType<A2>::BaseType cA2;
-      typename GetUnQualifiedType<A3>::BaseType cA3;
-      typename GetUnQualifiedType<A4>::BaseType cA4;
-      typename GetUnQualifiedType<A5>::BaseType cA5;
-      typename GetUnQualifiedType<A6>::BaseType cA6;
-      typename GetUnQualifiedType<A7>::BaseType cA7;
-      ReflectionWrite(a1, cA1, data);
-      ReflectionWrite(a2, cA2, data);
-      ReflectionWrite(a3, cA3, data);
-      ReflectionWrite(a4, cA4, data);
-      ReflectionWrite(a5, cA5, data);
-      ReflectionWrite(a6, cA6, data);
-      ReflectionWrite(a7, cA7, data);
-      switch (numFuncArgs_)
-        {
-        case 0:
-          (selfCasted->*m0_)();
-          break;
-        case 1:
-          (selfCasted->*m1_)(cA1);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          break;
-        case 2:
-          (selfCasted->*m2_)(cA1, cA2);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          break;
-        case 3:
-          (selfCasted->*m3_)(cA1, cA2, cA3);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          break;
-        case 4:
-          (selfCasted->*m4_)(cA1, cA2, cA3, cA4);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          break;
-        case 5:
-          (selfCasted->*m5_)(cA1, cA2, cA3, cA4, cA5);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          break;
-        case 6:
-          (selfCasted->*m6_)(cA1, cA2, cA3, cA4,cA5, cA6);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          break;
-        case 7:
-          (selfCasted->*m7_)(cA1, cA2, cA3, cA4,cA5, cA6, cA7);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          ReferenceArgument<A7>::convert(a7, cA7, data);
-          break;
-        case 8:
-          (selfCasted->*m0c_)();
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          break;
-        case 9:
-          (selfCasted->*m1c_)(cA1);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          break;
-        case 10:
-          (selfCasted->*m2c_)(cA1, cA2);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          break;
-        case 11:
-          (selfCasted->*m3c_)(cA1, cA2, cA3);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          break;
-        case 12:
-          (selfCasted->*m4c_)(cA1, cA2, cA3, cA4);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          break;
-        case 13:
-          (selfCasted->*m5c_)(cA1, cA2, cA3, cA4, cA5);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          break;
-        case 14:
-          (selfCasted->*m6c_)(cA1, cA2, cA3,cA4,cA5,cA6);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          break;
-        case 15:
-          (selfCasted->*m7c_)(cA1, cA2, cA3,cA4,cA5,cA6,cA7);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          ReferenceArgument<A7>::convert(a7, cA7, data);
-          break;
-        default:
-          throw std::runtime_error("Impossible");
-        }
+      arguments.apply(f);
+      arguments.update();
       return ReflectionNil(data);
     }
-private:
-  union
+};
+
+  // A method of a class
+class MethodBase
+{
+public:
+  MethodBase() : isStatic_(false) {}
+  virtual ~MethodBase() = default;
+  // args has getNumArgs() elements
+  virtual ReflectionHandle call(void * self, void * data,
+                                const ReflectionHandle * args) = 0;
+  unsigned int getNumArgs() const { return numArgs_; }
+  bool isStatic() const { return isStatic_; }
+  const Signature & signature() const { return signature_; }
+  void setPolicies(const Policies & policies)
     {
-      void (T::*m0_)();
-      void (T::*m1_)(A1);
-      void (T::*m2_)(A1, A2);
-      void (T::*m3_)(A1, A2, A3);
-      void (T::*m4_)(A1, A2, A3, A4);
-      void (T::*m5_)(A1, A2, A3, A4, A5);
-      void (T::*m6_)(A1, A2, A3, A4, A5, A6);
-      void (T::*m7_)(A1, A2, A3, A4, A5, A6, A7);
-      void (T::*m0c_)() const;
-      void (T::*m1c_)(A1) const;
-      void (T::*m2c_)(A1, A2) const;
-      void (T::*m3c_)(A1, A2, A3) const;
-      void (T::*m4c_)(A1, A2, A3, A4) const;
-      void (T::*m5c_)(A1, A2, A3, A4, A5) const;
-      void (T::*m6c_)(A1, A2, A3, A4, A5, A6) const;
-      void (T::*m7c_)(A1, A2, A3, A4, A5, A6, A7) const;
-    };
+      policies.check(numArgs_ + (isStatic_ ? 1 : 2));
+      policies_ = policies;
+    }
+
+protected:
+  unsigned int numArgs_;
+  bool isStatic_;
+  Signature signature_;
+  Policies policies_;
 };
 
-// Static method with up to 7 arguments returning non-void
-template<typename R,
-         typename A1=NoClass, typename A2=NoClass, typename A3=NoClass,
-         typename A4=NoClass, typename A5=NoClass, typename A6=NoClass,
-         typename A7=NoClass>
-struct Function : public MethodBase
+  // Method of class T, MemberFunction is R (T::*)(Args...) with or without
+  // const
+template<typename MemberFunction, typename T, typename R, typename... Args>
+struct MemberMethod : public MethodBase
 {
 public:
-  Function(void * m) : functionPointer_((void*)m)
+  MemberMethod(MemberFunction m) : m_(m)
   {
-    isStatic_ = true;
-    numFuncArgs_ = CountArguments<A1,A2,A3,A4,A5,A6,A7>::value;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make();
+    numArgs_ = sizeof...(Args);
+    signature_ = MakeSignature<Args...>::make();
   }
 
   virtual ReflectionHandle call(void * self, void * data,
-                                ReflectionHandle a1, ReflectionHandle a2,
-                                ReflectionHandle a3, ReflectionHandle a4,
-                                ReflectionHandle a5, ReflectionHandle a6,
-                                ReflectionHandle a7)
+                                const ReflectionHandle * args) override
     {
-      typename GetUnQualifiedType<A1>::BaseType cA1;
-      typename GetUnQualifiedType<A2>::BaseType cA2;
-      typename GetUnQualifiedType<A3>::BaseType cA3;
-      typename GetUnQualifiedType<A4>::BaseType cA4;
-      typename GetUnQualifiedType<A5>::BaseType cA5;
-      typename GetUnQualifiedType<A6>::BaseType cA6;
-      typename GetUnQualifiedType<A6>::BaseType cA7;
-      ReflectionWrite(a1, cA1, data);
-      ReflectionWrite(a2, cA2, data);
-      ReflectionWrite(a3, cA3, data);
-      ReflectionWrite(a4, cA4, data);
-      ReflectionWrite(a5, cA5, data);
-      ReflectionWrite(a6, cA6, data);
-      ReflectionWrite(a7, cA7, data);
-      ReflectionHandle result;
-      switch ((int)CountArguments<A1,A2,A3,A4,A5,A6,A7>::value)
+      T * selfCasted = (T*)self;
+      ArgumentPack<Args...> arguments(args, data);
+      MemberFunction m = m_;
+      ReflectionHandle result =
+        CallAndRead<R>::call(arguments,
+                             [selfCasted, m](auto && ... args) -> R
+                               {
+                                 return (selfCasted->*m)(
+                                   std::forward<decltype(args)>(args)...);
+                               },
+                             policies_, data);
+      if (policies_.needsKeepAlive())
         {
-        case 0 :
-          return ReflectionRead(((R(*)())functionPointer_)(), data);
-        case 1 :
-          result = ReflectionRead(((R(*)(A1))functionPointer_)(cA1), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          return result;
-        case 2 :
-          result = ReflectionRead(((R(*)(A1,A2))functionPointer_)(cA1,cA2),
-                                  data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          return result;
-        case 3 :
-          result = ReflectionRead(((R(*)(A1,A2,A3))functionPointer_)
-                                  (cA1,cA2,cA3), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          return result;
-        case 4 :
-          result = ReflectionRead(((R(*)(A1,A2,A3,A4))functionPointer_)
-                                  (cA1,cA2,cA3,cA4), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          return result;
-        case 5 :
-          result = ReflectionRead(((R(*)(A1,A2,A3,A4,A5))functionPointer_)
-                                  (cA1,cA2,cA3,cA4,cA5), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          return result;
-        case 6 :
-          result = ReflectionRead(((R(*)(A1,A2,A3,A4,A5,A6))functionPointer_)
-                                  (cA1,cA2,cA3,cA4,cA5,cA6), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          return result;
-        case 7 :
-          result = ReflectionRead(((R(*)(A1,A2,A3,A4,A5,A6,A7))functionPointer_)
-                                  (cA1,cA2,cA3,cA4,cA5,cA6,cA7), data);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          ReferenceArgument<A7>::convert(a7, cA7, data);
+          ReflectionHandle handles[sizeof...(Args) + 2];
+          handles[0] = result;
+          handles[1] = ReflectionScriptObject(selfCasted, data);
+          std::copy(args, args + sizeof...(Args), handles + 2);
+          applyKeepAlive(policies_, handles, sizeof...(Args) + 2, data);
         }
-      return ReflectionNil(data);
+      return result;
     }
 private:
-  void * functionPointer_;
+  MemberFunction m_;
+};
+
+template<typename MemberFunction>
+struct Method;
+
+template<typename T, typename R, typename... Args>
+struct Method<R (T::*)(Args...)>
+  : public MemberMethod<R (T::*)(Args...), T, R, Args...>
+{
+  Method(R (T::*m)(Args...))
+    : MemberMethod<R (T::*)(Args...), T, R, Args...>(m) {}
+};
+
+template<typename T, typename R, typename... Args>
+struct Method<R (T::*)(Args...) const>
+  : public MemberMethod<R (T::*)(Args...) const, T, R, Args...>
+{
+  Method(R (T::*m)(Args...) const)
+    : MemberMethod<R (T::*)(Args...) const, T, R, Args...>(m) {}
 };
 
-// Static method with up to 7 arguments returning void
-template<typename A1, typename A2, typename A3,
-         typename A4, typename A5, typename A6,
-         typename A7>
-struct Function<void,A1,A2,A3,A4,A5,A6,A7> : public MethodBase
+// Static method or global function
+template<typename R, typename... Args>
+struct Function : public MethodBase
 {
 public:
-  Function(void * m) : functionPointer_((void*)m)
+  Function(R (*f)(Args...)) : functionPointer_(f)
   {
     isStatic_ = true;
-    numFuncArgs_ = CountArguments<A1,A2,A3,A4,A5,A6,A7>::value;
-    signature_ = MakeSignature<A1,A2,A3,A4,A5,A6,A7>::make();
+    numArgs_ = sizeof...(Args);
+    signature_ = MakeSignature<Args...>::make();
   }
+  // f must point to a R(Args...) function
+  Function(void * f) : Function((R (*)(Args...))f) {}
 
-  virtual ReflectionHandle call(void * self, void * data,
-                                ReflectionHandle a1, ReflectionHandle a2,
-                                ReflectionHandle a3, ReflectionHandle a4,
-                                ReflectionHandle a5, ReflectionHandle a6,
-                                ReflectionHandle a7)
+  virtual ReflectionHandle call(void * self __attribute__((unused)),
+                                void * data,
+                                const ReflectionHandle * args) override
     {
-      typename GetUnQualifiedType<A1>::BaseType cA1;
-      typename GetUnQualifiedType<A2>::BaseType cA2;
-      typename GetUnQualifiedType<A3>::BaseType cA3;
-      typename GetUnQualifiedType<A4>::BaseType cA4;
-      typename GetUnQualifiedType<A5>::BaseType cA5;
-      typename GetUnQualifiedType<A6>::BaseType cA6;
-      typename GetUnQualifiedType<A7>::BaseType cA7;
-      ReflectionWrite(a1, cA1, data);
-      ReflectionWrite(a2, cA2, data);
-      ReflectionWrite(a3, cA3, data);
-      ReflectionWrite(a4, cA4, data);
-      ReflectionWrite(a5, cA5, data);
-      ReflectionWrite(a6, cA6, data);
-      ReflectionWrite(a7, cA7, data);
-      switch ((int)CountArguments<A1,A2,A3,A4,A5,A6,A7>::value)
+      ArgumentPack<Args...> arguments(args, data);
+      ReflectionHandle result =
+        CallAndRead<R>::call(arguments, functionPointer_,
+                             policies_, data);
+      if (policies_.needsKeepAlive())
         {
-        case 0 :
-          ((void(*)())functionPointer_)();
-          break;
-        case 1 :
-          ((void(*)(A1))functionPointer_)(cA1);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          break;
-        case 2 :
-          ((void(*)(A1,A2))functionPointer_)(cA1,cA2);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          break;
-        case 3 :
-          ((void(*)(A1,A2,A3))functionPointer_)(cA1,cA2,cA3);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          break;
-        case 4 :
-          ((void(*)(A1,A2,A3,A4))functionPointer_)(cA1,cA2,cA3,cA4);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          break;
-        case 5 :
-          ((void(*)(A1,A2,A3,A4,A5))functionPointer_)(cA1,cA2,cA3,cA4,cA5);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          break;
-        case 6 :
-          ((void(*)(A1,A2,A3,A4,A5,A6))functionPointer_)
-            (cA1,cA2,cA3,cA4,cA5,cA6);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          break;
-        case 7 :
-          ((void(*)(A1,A2,A3,A4,A5,A6,A7))functionPointer_)
-            (cA1,cA2,cA3,cA4,cA5,cA6,cA7);
-          ReferenceArgument<A1>::convert(a1, cA1, data);
-          ReferenceArgument<A2>::convert(a2, cA2, data);
-          ReferenceArgument<A3>::convert(a3, cA3, data);
-          ReferenceArgument<A4>::convert(a4, cA4, data);
-          ReferenceArgument<A5>::convert(a5, cA5, data);
-          ReferenceArgument<A6>::convert(a6, cA6, data);
-          ReferenceArgument<A7>::convert(a7, cA7, data);
-          break;
+          ReflectionHandle handles[sizeof...(Args) + 1];
+          handles[0] = result;
+          std::copy(args, args + sizeof...(Args), handles + 1);
+          applyKeepAlive(policies_, handles, sizeof...(Args) + 1, data);
         }
-      return ReflectionNil(data);
+      return result;
     }
 private:
-  void * functionPointer_;
+  R (*functionPointer_)(Args...);
 };
 }
 
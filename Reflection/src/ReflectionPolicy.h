@@ -0,0 +1,177 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ReflectionPolicy_h_
+#define ReflectionPolicy_h_
+
+#include "ReflectionImplement.h"
+#include "ScriptStringCache.h"
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Reflection
+{
+
+  // How an exported class returned by reference or pointer (from a method
+  // or an attribute) is handed to the script.  Other types are always
+  // converted.
+enum class ReturnPolicy
+{
+  automatic,         // references are copied, pointers are owned by C++
+  copy,              // the script gets its own copy
+  move,              // the script gets its own object, moved from the result
+  reference,         // the script refers to the C++ object without owning it
+  reference_internal // reference, and the result keeps self alive
+};
+
+  // Return std::string results through ScriptStringCache, for methods and
+  // attributes that return the same few values over and over
+struct intern_strings
+{
+};
+
+  // Keep the script object at index Patient alive as long as the one at
+  // index Nurse.  0 is the return value, for methods 1 is self and the
+  // arguments start at 2, for static methods they start at 1.
+template <unsigned int Nurse, unsigned int Patient>
+struct keep_alive
+{
+};
+
+  // The policies given when exporting a method or attribute
+struct Policies
+{
+  Policies() {}
+  template <typename First, typename... Rest,
+            typename = typename std::enable_if<
+              !std::is_same<First, Policies>::value>::type>
+  Policies(First first, Rest... rest)
+    {
+      add(first);
+      (void)std::initializer_list<int>{ 0, (add(rest), 0)... };
+    }
+
+  bool needsKeepAlive() const
+    {
+      return returnPolicy == ReturnPolicy::reference_internal ||
+        !keepAlive.empty();
+    }
+  // Throws if a keep_alive refers past the last of numHandles indices
+  void check(unsigned int numHandles) const;
+
+  ReturnPolicy returnPolicy = ReturnPolicy::automatic;
+  bool internStrings = false;
+  // nurse, patient
+  std::vector<std::pair<unsigned int, unsigned int> > keepAlive;
+
+private:
+  void add(ReturnPolicy policy) { returnPolicy = policy; }
+  void add(intern_strings) { internStrings = true; }
+  template <unsigned int Nurse, unsigned int Patient>
+  void add(keep_alive<Nurse, Patient>) { keepAlive.push_back({Nurse, Patient}); }
+};
+
+  // Convert the result R of a method or attribute as policy says
+template <typename R, typename Enable = void>
+struct ReadWithPolicy
+{
+  static ReflectionHandle read(R && value,
+                               const Policies & policies
+                                 __attribute__((unused)),
+                               void * data)
+    {
+      return ReflectionRead(std::forward<R>(value), data);
+    }
+};
+
+template <typename R>
+struct ReadWithPolicy<R,
+  typename std::enable_if<std::is_same<typename std::decay<R>::type,
+                                       std::string>::value>::type>
+{
+  static ReflectionHandle read(const std::string & value,
+                               const Policies & policies, void * data)
+    {
+      if (policies.internStrings)
+        return ScriptStringCache::read(value, data);
+      return ReflectionRead(value, data);
+    }
+};
+
+template <typename R>
+struct ReadWithPolicy<R &,
+  typename std::enable_if<std::is_base_of<ScriptAccess,
+                            typename std::remove_const<R>::type>::value>::type>
+{
+  typedef typename std::remove_const<R>::type T;
+
+  static ReflectionHandle read(R & value, const Policies & policies,
+                               void * data)
+    {
+      switch (policies.returnPolicy)
+        {
+        case ReturnPolicy::reference :
+        case ReturnPolicy::reference_internal :
+          return ReflectionReadBorrowed(const_cast<T*>(&value), data);
+        case ReturnPolicy::move :
+          return moveOrCopy(value, data);
+        default :
+          return ReflectionRead(static_cast<const T &>(value), data);
+        }
+    }
+
+private:
+  // A const result can only be copied
+  static ReflectionHandle moveOrCopy(T & value, void * data)
+    { return ReflectionRead(std::move(value), data); }
+  static ReflectionHandle moveOrCopy(const T & value, void * data)
+    { return ReflectionRead(value, data); }
+};
+
+template <typename R>
+struct ReadWithPolicy<R *,
+  typename std::enable_if<std::is_base_of<ScriptAccess,
+                            typename std::remove_const<R>::type>::value>::type>
+{
+  typedef typename std::remove_const<R>::type T;
+
+  static ReflectionHandle read(R * value, const Policies & policies,
+                               void * data)
+    {
+      if (value == nullptr)
+        return ReflectionNil(data);
+      switch (policies.returnPolicy)
+        {
+        case ReturnPolicy::reference :
+        case ReturnPolicy::reference_internal :
+          return ReflectionReadBorrowed(const_cast<T*>(value), data);
+        case ReturnPolicy::copy :
+        case ReturnPolicy::move :
+          return ReadWithPolicy<R &>::read(*value, policies, data);
+        default :
+          return ReflectionRead(const_cast<T*>(value), data);
+        }
+    }
+};
+
+  // Apply the keep_alive policies (and reference_internal) after a call.
+  // handles[i] is the script object of index i (see keep_alive).
+void applyKeepAlive(const Policies & policies, const ReflectionHandle * handles,
+                    unsigned int numHandles, void * data);
+
+}
+
+#endif
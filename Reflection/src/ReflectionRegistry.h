@@ -51,7 +51,8 @@
                                                    #klass, \
                                                    typeid(klass).name(), \
                                                    typeid(klass*).name(), \
-                                                   typeid(parent).name()); \
+                                                   typeid(parent).name(), \
+                                                   &Reflection::upcast<klass, parent>); \
     return 0; \
   } \
   static Reflection::ClassBase * init_reflection_##klass() \
@@ -62,6 +63,12 @@
 #define DEF_A(a) \
   def_a(#a, &WrappedClass::a)
 
+#define DEF_BUFFER(a) \
+  def_buffer(#a, &WrappedClass::a)
+
+#define DEF_VIEW(a) \
+  def_view(#a, &WrappedClass::a)
+
 #define DEF_F(f) \
   def_f(#f, &WrappedClass::f)
 
@@ -69,6 +76,14 @@
 namespace Reflection
 {
 
+  // Upcast from Derived to its base class Base, pass it to registerClass for
+  // a second base class
+template<typename Derived, typename Base>
+void * upcast(void * object)
+{
+  return static_cast<Base*>(static_cast<Derived*>(object));
+}
+
 class Registry
 {
 public:
@@ -85,7 +100,8 @@ public:
                      const std::string & className,
                      const std::string & classTypeIdName,
                      const std::string & pointerClassTypeIdName,
-                     const std::string & parent);
+                     const std::string & parent,
+                     Upcast upcast = nullptr);
   void init();
 
   // Array is sorted by inheritance
@@ -94,6 +110,9 @@ public:
 
   bool isInheritedFrom(const std::string & derived,
                        const std::string & base) const;
+  bool isInheritedFrom(TypeId derived, TypeId base) const;
+  // Return typeIdNil if pointer is not a pointer to a reflected class
+  TypeId pointerToClass(TypeId pointer) const;
   // Return empty string if no match was found
   std::string pointerToClassname(const std::string & pointerName) const;
   // Return empty string if no match was found
@@ -106,6 +125,9 @@ private:
   typedef std::multimap<std::string, std::string> InheritanceMap;
   typedef std::unordered_map<std::string, std::string> StringMap;
   typedef std::unordered_map<std::string, ClassBase *> ClassMap;
+  typedef std::unordered_multimap<TypeId, TypeId> InheritanceIdMap;
+  typedef std::unordered_map<TypeId, TypeId> TypeIdMap;
+  typedef std::map<std::pair<std::string, std::string>, Upcast> UpcastMap;
 
   Registry();
   ~Registry();
@@ -117,6 +139,11 @@ private:
   ClassMap classMap_;
   StringMap pointerToObjectMap_;
   StringMap typeidToClassname_;
+  // Same as inheritanceMap_ and pointerToObjectMap_, for signature matching
+  InheritanceIdMap inheritanceIdMap_;
+  TypeIdMap pointerToObjectIdMap_;
+  // Per (derived, parent) in inheritanceMap_, when given
+  UpcastMap upcasts_;
 };
 
 }
@@ -0,0 +1,146 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ReflectionTypeId_h_
+#define ReflectionTypeId_h_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+namespace Reflection
+{
+
+  // Compact identifier of a type, used in signatures.
+  // Each typeid().name() is interned once and gets a small number.  The high
+  // bits count how many times the type is wrapped in an array (std::vector),
+  // so "array array i" is still a single integer.
+typedef uint32_t TypeId;
+typedef std::vector<TypeId> Signature;
+
+const unsigned int typeIdArrayShift = 28;
+const TypeId typeIdArrayStep = 1u << typeIdArrayShift;
+
+  // Predefined ids for things scripts pass that are not a C++ type
+const TypeId typeIdNil = 0;        // nil/None, matches any pointer
+const TypeId typeIdEmptyArray = 1; // matches any array
+const TypeId typeIdPackedArray = 2; // buffer, matches any array of numbers
+const TypeId typeIdBinaryString = 3; // matches a string or array of numbers
+const TypeId typeIdHash = 4;       // ruby hash, python dict, matches any map
+
+inline bool isArrayTypeId(TypeId id) { return id >= typeIdArrayStep; }
+inline TypeId arrayTypeId(TypeId element) { return element + typeIdArrayStep; }
+inline TypeId arrayElementTypeId(TypeId array)
+  { return array - typeIdArrayStep; }
+
+  // Get the id for a typeid().name().  A name starting with "array " gives the
+  // array id of the rest of the name.
+TypeId internTypeId(const std::string & typeidName);
+  // Inverse of internTypeId, arrays are returned as "array <name>"
+std::string typeIdToName(TypeId id);
+  // Get the id of a std::map or std::unordered_map, remembering it is a map
+TypeId internMapTypeId(const std::string & typeidName);
+bool isMapTypeId(TypeId id);
+
+  // Get the id of a type or an array, computed once per type
+template<typename T>
+struct TypeIdOf
+{
+  static TypeId id()
+    {
+      static const TypeId result = internTypeId(typeid(T).name());
+      return result;
+    }
+};
+
+template<typename T>
+struct TypeIdOf<std::vector<T> >
+{
+  static TypeId id() { return arrayTypeId(TypeIdOf<T>::id()); }
+};
+
+template<typename T>
+struct TypeIdOf<std::vector<T> const &>
+{
+  static TypeId id() { return arrayTypeId(TypeIdOf<T>::id()); }
+};
+
+template<typename T>
+struct TypeIdOf<std::vector<T> &>
+{
+  static TypeId id() { return arrayTypeId(TypeIdOf<T>::id()); }
+};
+
+  // Smart pointers match like plain pointers
+template<typename T>
+struct TypeIdOf<std::shared_ptr<T> > : TypeIdOf<T*> {};
+template<typename T>
+struct TypeIdOf<std::shared_ptr<T> const &> : TypeIdOf<T*> {};
+template<typename T>
+struct TypeIdOf<std::unique_ptr<T> > : TypeIdOf<T*> {};
+
+template<typename Map>
+struct MapTypeIdOf
+{
+  static TypeId id()
+    {
+      static const TypeId result = internMapTypeId(typeid(Map).name());
+      return result;
+    }
+};
+
+template<typename Key, typename Value>
+struct TypeIdOf<std::map<Key, Value> >
+  : MapTypeIdOf<std::map<Key, Value> > {};
+template<typename Key, typename Value>
+struct TypeIdOf<std::map<Key, Value> const &>
+  : MapTypeIdOf<std::map<Key, Value> > {};
+template<typename Key, typename Value>
+struct TypeIdOf<std::map<Key, Value> &>
+  : MapTypeIdOf<std::map<Key, Value> > {};
+template<typename Key, typename Value>
+struct TypeIdOf<std::unordered_map<Key, Value> >
+  : MapTypeIdOf<std::unordered_map<Key, Value> > {};
+template<typename Key, typename Value>
+struct TypeIdOf<std::unordered_map<Key, Value> const &>
+  : MapTypeIdOf<std::unordered_map<Key, Value> > {};
+template<typename Key, typename Value>
+struct TypeIdOf<std::unordered_map<Key, Value> &>
+  : MapTypeIdOf<std::unordered_map<Key, Value> > {};
+
+#if __cplusplus >= 201703L
+  // A string_view argument takes any string
+template<>
+struct TypeIdOf<std::string_view>
+{
+  static TypeId id() { return TypeIdOf<std::string>::id(); }
+};
+
+template<>
+struct TypeIdOf<std::string_view const &>
+{
+  static TypeId id() { return TypeIdOf<std::string>::id(); }
+};
+#endif
+
+}
+
+#endif
@@ -15,6 +15,7 @@
 #ifndef ReflectionUtil_h_
 #define ReflectionUtil_h_
 
+#include "ReflectionTypeId.h"
 #include <vector>
 #include <string>
 #include <typeinfo>
@@ -44,170 +45,17 @@ struct GetUnQualifiedType<const T &>
   typedef T BaseType;
 };
 
-  // A empty class used as default template argument in some places
-  struct NoClass {};
-
-  // Get typeid(T).name() of a type or an array
-template<typename T>
-struct TypeIdName
-{
-  static std::string name() { return typeid(T).name(); }
-};
-
-template<typename T>
-struct TypeIdName<std::vector<T> >
-{
-  static std::string name() { return std::string("array ") +
-                                     TypeIdName<T>::name(); }
-};
-
-template<typename T>
-struct TypeIdName<std::vector<T> const &>
-{
-  static std::string name() { return std::string("array ") +
-                                     TypeIdName<T>::name(); }
-};
-
-template<typename T>
-struct TypeIdName<std::vector<T> &>
-{
-  static std::string name() { return std::string("array ") +
-                                     TypeIdName<T>::name(); }
-};
-
-  // Count the number of arguments
-  template<typename A1, typename A2, typename A3, typename A4, typename A5,
-           typename A6, typename A7>
-  struct CountArguments { enum { value = 7 }; };
-
-  template<>
-  struct CountArguments<NoClass, NoClass, NoClass, NoClass, NoClass, NoClass,
-                        NoClass>
-    { enum { value = 0 }; };
-  template<typename A1>
-  struct CountArguments<A1, NoClass, NoClass, NoClass, NoClass, NoClass,
-                        NoClass>
-    { enum { value = 1 }; };
-  template<typename A1, typename A2>
-  struct CountArguments<A1, A2, NoClass, NoClass, NoClass, NoClass, NoClass>
-    { enum { value = 2 }; };
-  template<typename A1, typename A2, typename A3>
-  struct CountArguments<A1, A2, A3, NoClass, NoClass, NoClass, NoClass>
-    { enum { value = 3 }; };
-  template<typename A1, typename A2, typename A3, typename A4>
-  struct CountArguments<A1, A2, A3, A4, NoClass, NoClass, NoClass>
-    { enum { value = 4 }; };
-  template<typename A1, typename A2, typename A3, typename A4, typename A5>
-  struct CountArguments<A1, A2, A3, A4, A5, NoClass, NoClass>
-    { enum { value = 5 }; };
-  template<typename A1, typename A2, typename A3, typename A4, typename A5,
-           typename A6>
-  struct CountArguments<A1, A2, A3, A4, A5, A6, NoClass>
-    { enum { value = 6 }; };
+  // Most arguments an exported function or constructor, or a call into a
+  // script, can have.  Checked at compile time.
+  const unsigned int maxArguments = 16;
 
   // Make a signature
-  template<typename A1, typename A2, typename A3, typename A4, typename A5,
-           typename A6, typename A7>
+  template<typename... Args>
   struct MakeSignature
   {
-    static std::vector<std::string> make()
-      {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        result.push_back(TypeIdName<A2>::name());
-        result.push_back(TypeIdName<A3>::name());
-        result.push_back(TypeIdName<A4>::name());
-        result.push_back(TypeIdName<A5>::name());
-        result.push_back(TypeIdName<A6>::name());
-        result.push_back(TypeIdName<A7>::name());
-        return result;
-      }
-  };
-  template<>
-  struct MakeSignature<NoClass, NoClass, NoClass, NoClass, NoClass, NoClass,
-                       NoClass>
-  {
-    static std::vector<std::string> make()
-      {
-        return std::vector<std::string>();
-      }
-  };
-  template<typename A1>
-  struct MakeSignature<A1, NoClass, NoClass, NoClass, NoClass, NoClass, NoClass>
-  {
-    static std::vector<std::string> make()
-      {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        return result;
-      }
-  };
-  template<typename A1, typename A2>
-  struct MakeSignature<A1, A2, NoClass, NoClass, NoClass, NoClass, NoClass>
-  {
-    static std::vector<std::string> make()
-      {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        result.push_back(TypeIdName<A2>::name());
-        return result;
-      }
-  };
-  template<typename A1, typename A2, typename A3>
-  struct MakeSignature<A1, A2, A3, NoClass, NoClass, NoClass, NoClass>
-  {
-    static std::vector<std::string> make()
-      {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        result.push_back(TypeIdName<A2>::name());
-        result.push_back(TypeIdName<A3>::name());
-        return result;
-      }
-  };
-  template<typename A1, typename A2, typename A3,
-           typename A4>
-  struct MakeSignature<A1, A2, A3, A4, NoClass, NoClass, NoClass>
-  {
-    static std::vector<std::string> make()
-      {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        result.push_back(TypeIdName<A2>::name());
-        result.push_back(TypeIdName<A3>::name());
-        result.push_back(TypeIdName<A4>::name());
-        return result;
-      }
-  };
-  template<typename A1, typename A2, typename A3,
-           typename A4, typename A5>
-  struct MakeSignature<A1, A2, A3, A4, A5, NoClass, NoClass>
-  {
-    static std::vector<std::string> make()
-      {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        result.push_back(TypeIdName<A2>::name());
-        result.push_back(TypeIdName<A3>::name());
-        result.push_back(TypeIdName<A4>::name());
-        result.push_back(TypeIdName<A5>::name());
-        return result;
-      }
-  };
-  template<typename A1, typename A2, typename A3,
-           typename A4, typename A5, typename A6>
-  struct MakeSignature<A1, A2, A3, A4, A5, A6, NoClass>
-  {
-    static std::vector<std::string> make()
+    static Signature make()
       {
-        std::vector<std::string> result;
-        result.push_back(TypeIdName<A1>::name());
-        result.push_back(TypeIdName<A2>::name());
-        result.push_back(TypeIdName<A3>::name());
-        result.push_back(TypeIdName<A4>::name());
-        result.push_back(TypeIdName<A5>::name());
-        result.push_back(TypeIdName<A6>::name());
-        return result;
+        return Signature{ TypeIdOf<Args>::id()... };
       }
   };
 }
@@ -15,8 +15,12 @@
 #ifndef AbstractPointer_h_
 #define AbstractPointer_h_
 
+#include <cstddef>
+#include <memory>
 #include <string>
 
+class ScriptObject;
+
 // A wrapper for a virtual destructor
 class AbstractPointer
 {
@@ -26,6 +30,23 @@ public:
 
   virtual void * get() const = 0;
   virtual std::string typeidName() const = 0;
+  // The shared_ptr owning the object, empty when it isn't shared
+  virtual std::shared_ptr<void> getSharedPtr() const = 0;
+  // Give up ownership : the object is returned and get() becomes nullptr.
+  // Throws when the object is shared or borrowed.
+  virtual void * release() = 0;
+  // The object was destroyed by its owner (it is borrowed) : get() becomes
+  // nullptr and the object is no longer touched
+  virtual void forget() = 0;
+  // Memory owned through this pointer, 0 when the object isn't owned
+  virtual size_t memsize() const = 0;
+  // sizeof the object when this pointer is its only owner (not borrowed nor
+  // shared), else 0
+  virtual size_t ownedSize() const = 0;
+  // Call visit(scriptObject, arg) for the ScriptObjects the object holds,
+  // when its class reports them (see ScriptObject.h)
+  virtual void visitScriptObjects(void (*visit)(ScriptObject &, void *),
+                                  void * arg) = 0;
 };
 
 #endif
@@ -0,0 +1,141 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CallSiteCache_h_
+#define CallSiteCache_h_
+
+#include <cstdint>
+
+// Overload resolution (signature building + typeIdMatches) is expensive and
+// a call site in a script almost always passes the same argument types.
+// A CallSiteCache remembers the last few resolutions of one call site (one
+// exported method name, constructor set or global function), keyed on the
+// receiver class and the kind of each argument.
+//
+// An argument kind is a cheap summary of a script value, computed without
+// allocating.  Two values with the same kind must always resolve to the same
+// C++ type, e.g. ruby : (T_DATA, class of object), (T_ARRAY, kind of first
+// element).  Building the kinds is done by the language specific code in
+// ScriptInterface.C.
+
+struct CallSiteCacheStatistics
+{
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long uncacheable;
+};
+
+class CallSiteCacheBase
+{
+public:
+  static const unsigned int maxArguments = 7;
+  static const unsigned int numEntries = 4;
+
+  struct ArgumentKind
+  {
+    uintptr_t type;
+    uintptr_t detail;
+  };
+
+  struct Key
+  {
+    const void * receiver;
+    unsigned int numArguments;
+    ArgumentKind arguments[maxArguments];
+  };
+
+  static const CallSiteCacheStatistics & statistics() { return statistics_; }
+  static void resetStatistics();
+  // Count a call that couldn't use a cache
+  static void uncacheable() { ++statistics_.uncacheable; }
+  // Forget all cached resolutions, e.g. when type equalities change
+  static void invalidateAll() { ++globalGeneration_; }
+
+protected:
+  static bool equal(const Key & key1, const Key & key2);
+
+  static CallSiteCacheStatistics statistics_;
+  static unsigned int globalGeneration_;
+};
+
+template <typename Target>
+class CallSiteCache : public CallSiteCacheBase
+{
+public:
+  CallSiteCache() : numUsed_(0), next_(0), generation_(globalGeneration_) {}
+
+  // Return the cached target for key or nullptr
+  Target * lookup(const Key & key);
+  // Remember target for key, replacing the oldest entry when full
+  void insert(const Key & key, Target * target);
+
+private:
+  struct Entry
+  {
+    Key key;
+    Target * target;
+  };
+
+  Entry entries_[numEntries];
+  unsigned int numUsed_;
+  unsigned int next_;
+  unsigned int generation_;
+};
+
+inline bool CallSiteCacheBase::equal(const Key & key1, const Key & key2)
+{
+  if (key1.receiver != key2.receiver ||
+      key1.numArguments != key2.numArguments)
+    return false;
+  for (unsigned int arg=0; arg<key1.numArguments; ++arg)
+    {
+      if (key1.arguments[arg].type != key2.arguments[arg].type ||
+          key1.arguments[arg].detail != key2.arguments[arg].detail)
+        return false;
+    }
+  return true;
+}
+
+template <typename Target>
+Target * CallSiteCache<Target>::lookup(const Key & key)
+{
+  if (generation_ != globalGeneration_)
+    {
+      numUsed_ = 0;
+      next_ = 0;
+      generation_ = globalGeneration_;
+    }
+  for (unsigned int entry=0; entry<numUsed_; ++entry)
+    {
+      if (equal(entries_[entry].key, key))
+        {
+          ++statistics_.hits;
+          return entries_[entry].target;
+        }
+    }
+  ++statistics_.misses;
+  return nullptr;
+}
+
+template <typename Target>
+void CallSiteCache<Target>::insert(const Key & key, Target * target)
+{
+  entries_[next_].key = key;
+  entries_[next_].target = target;
+  next_ = (next_ + 1) % numEntries;
+  if (numUsed_ < numEntries)
+    ++numUsed_;
+}
+
+#endif
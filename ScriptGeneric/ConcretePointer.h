@@ -21,11 +21,15 @@
 
 /// Pointer to an object with an optional shared_ptr to prevent deletion in C++
 /// when the object is still in use in the scripting language.
+/// A borrowed object belongs to someone else and is never deleted, only
+/// detached from the reference.
 template<typename T>
 class ConcretePointer : public AbstractPointer
 {
 public:
-  ConcretePointer(T * object, bool fromSharedPtr);
+  ConcretePointer(T * object, bool fromSharedPtr, bool borrowed = false);
+  // Shares ownership of object with the other shared_ptrs
+  ConcretePointer(std::shared_ptr<T> object);
   ~ConcretePointer();
 
   T * operator->() const { return object_; }
@@ -33,11 +37,22 @@ public:
 
   virtual void * get() const override { return object_; }
   virtual std::string typeidName() const { return typeid(T).name(); }
+  virtual std::shared_ptr<void> getSharedPtr() const override
+    { return sharedPtr_; }
+  virtual void * release() override;
+  virtual void forget() override { object_ = nullptr; }
+  // sizeof(T), plus object->scriptMemsize() for classes that have a
+  // size_t scriptMemsize() const member reporting the memory they own
+  virtual size_t memsize() const override;
+  virtual size_t ownedSize() const override;
+  virtual void visitScriptObjects(void (*visit)(ScriptObject &, void *),
+                                  void * arg) override;
 
 private:
   // When the shared pointer is in use, both of these point to the same thing.
   T * object_;
   std::shared_ptr<T> sharedPtr_;
+  bool borrowed_;
 };
 
 #include "ConcretePointer.C"
@@ -27,9 +27,17 @@
 #include "PythonException.h"
 #endif
 #include <type_traits>
+#include <initializer_list>
+#include <tuple>
+#include <utility>
 #include <algorithm>
 #include <deque>
 #include <map>
+#include <memory>
+#include <exception>
+#if __cplusplus >= 201703L
+#include <string_view>
+#endif
 
 #if !defined(SCRIPT_RUBY) && !defined(SCRIPT_PYTHON)
 #error "Define SCRIPT_RUBY or SCRIPT_PYTHON or both"
@@ -47,8 +55,62 @@ union ReflectionHandle
 
 class ScriptObject;
 
+// Binary data : a Ruby String with binary encoding (ASCII-8BIT) or Python
+// bytes in scripts, where a std::string is UTF-8 text.  Any string or
+// buffer is accepted as argument.
+class ScriptBytes : public std::string
+{
+public:
+  using std::string::string;
+  ScriptBytes() = default;
+  ScriptBytes(const std::string & value) : std::string(value) {}
+  ScriptBytes(std::string && value) : std::string(std::move(value)) {}
+};
+
 // Implemented in ScriptInterface.C
 std::string niceTypename(const std::string & typeidname);
+// Implemented in ReflectionImplement.C
+// The exception for a failed conversion of element item of a script array to
+// a C++ array of typeidname
+std::runtime_error arrayElementError(long item, const std::string & typeidname,
+                                     const std::exception & cause);
+// The same for an entry of a script hash converted to a C++ map
+std::runtime_error mapEntryError(const std::string & keyTypeidname,
+                                 const std::string & valueTypeidname,
+                                 const std::exception & cause);
+#ifdef SCRIPT_RUBY
+// Empty ruby hash with room for size entries (where ruby supports that)
+VALUE newRubyHash(size_t size);
+// Implemented in ScriptInterface.C
+// The data type of ruby objects of exported classes, their data is a
+// RubyPythonReference
+extern const rb_data_type_t rubyReferenceType;
+#endif
+// Throws if cppObject, the C++ object of a script object, was given away
+// (see ReflectionWrite of std::unique_ptr)
+void checkCppObject(const void * cppObject);
+extern const char * const movedCppObjectMessage;
+// The script object of self, without adding a reference, or nil if self
+// isn't known to the script
+ReflectionHandle ReflectionScriptObject(ScriptAccess * self, void * data);
+template <typename T>
+typename std::enable_if<std::is_convertible<T*, ScriptAccess*>::value,
+                        ReflectionHandle>::type
+ReflectionScriptObject(T * self, void * data)
+{
+  return ReflectionScriptObject(static_cast<ScriptAccess*>(self), data);
+}
+// Several ScriptAccess bases : which one has the reference is unknown
+template <typename T>
+typename std::enable_if<!std::is_convertible<T*, ScriptAccess*>::value,
+                        ReflectionHandle>::type
+ReflectionScriptObject(T * self __attribute__((unused)), void * data)
+{
+  return ReflectionScriptObject((ScriptAccess*)nullptr, data);
+}
+// Keep patient alive as long as nurse, see Reflection::keep_alive
+void ReflectionKeepAlive(ReflectionHandle nurse, ReflectionHandle patient,
+                         void * data);
 
 ////////////////////////////
 // Functions to implement //
@@ -63,6 +125,7 @@ ReflectionHandle ReflectionRead(long int value, void * data);
 ReflectionHandle ReflectionRead(long unsigned int value, void * data);
 ReflectionHandle ReflectionRead(bool value, void * data);
 ReflectionHandle ReflectionRead(const std::string & value, void * data);
+ReflectionHandle ReflectionRead(const ScriptBytes & value, void * data);
 ReflectionHandle ReflectionRead(unsigned long long value, void * data);
 ReflectionHandle ReflectionRead(long long int value, void * data);
 ReflectionHandle ReflectionRead(double value, void * data);
@@ -80,6 +143,7 @@ void ReflectionWrite(ReflectionHandle handle, long unsigned int & value,
 void ReflectionWrite(ReflectionHandle handle, long int & value, void * data);
 void ReflectionWrite(ReflectionHandle handle, bool & value, void * data);
 void ReflectionWrite(ReflectionHandle handle, std::string & value, void * data);
+void ReflectionWrite(ReflectionHandle handle, ScriptBytes & value, void * data);
 void ReflectionWrite(ReflectionHandle handle, unsigned long long & value,
                      void * data);
 void ReflectionWrite(ReflectionHandle handle, long long int & value,
@@ -88,21 +152,61 @@ void ReflectionWrite(ReflectionHandle handle, double & value,
                      void * data);
 void ReflectionWrite(ReflectionHandle handle, ScriptObject & value,
                      void * data);
+#if __cplusplus >= 201703L
+// A string_view argument borrows the buffer of the script string, it is only
+// valid during the call.  Returned string_views are copied like strings.
+inline ReflectionHandle ReflectionRead(std::string_view value, void * data);
+inline void ReflectionWrite(ReflectionHandle handle, std::string_view & value,
+                            void * data);
+#endif
 // vectors of something convertable
 template <typename T>
 ReflectionHandle ReflectionRead(std::vector<T> & value, void * data);
 template <typename T>
 ReflectionHandle ReflectionRead(const std::vector<T> & value, void * data);
+// Temporaries, e.g. returned by value : elements are moved, not copied
+template <typename T>
+ReflectionHandle ReflectionRead(std::vector<T> && value, void * data);
 template <typename T>
 void ReflectionWrite(ReflectionHandle handle, std::vector<T> & value,
                      void * data);
 
+// Zero-copy view of a vector of numbers, see ScriptCppBuffer.  owner is
+// the script object holding value.  Ruby gets a regular array.
+template <typename T>
+ReflectionHandle ReflectionReadBuffer(std::vector<T> & value, void * data,
+                                      ReflectionHandle owner);
+// Lazy view of value, see ScriptCppArrayView.  owner is the script object
+// holding value, the view keeps it alive.
+template <typename T>
+ReflectionHandle ReflectionReadView(std::vector<T> & value, void * data,
+                                    ReflectionHandle owner);
+
+// Smart pointers to exported classes.  The script object shares ownership
+// with a shared_ptr and takes over the object of a unique_ptr, without a
+// copy.  A unique_ptr member keeps its object, the script borrows it.
+template <typename T>
+ReflectionHandle ReflectionRead(const std::shared_ptr<T> & value, void * data);
+template <typename T>
+ReflectionHandle ReflectionRead(std::unique_ptr<T> && value, void * data);
+template <typename T>
+ReflectionHandle ReflectionRead(const std::unique_ptr<T> & value, void * data);
+template <typename T>
+void ReflectionWrite(ReflectionHandle handle, std::shared_ptr<T> & value,
+                     void * data);
+// Only for objects owned by the script, which it can't use afterwards
+template <typename T>
+void ReflectionWrite(ReflectionHandle handle, std::unique_ptr<T> & value,
+                     void * data);
+
 // deque
 template <typename T>
 ReflectionHandle ReflectionRead(std::deque<T> & value, void * data);
 template <typename T>
 ReflectionHandle ReflectionRead(const std::deque<T> & value, void * data);
 template <typename T>
+ReflectionHandle ReflectionRead(std::deque<T> && value, void * data);
+template <typename T>
 void ReflectionWrite(ReflectionHandle handle, std::deque<T> & value,
                      void * data);
 
@@ -114,6 +218,9 @@ template <typename Key, typename Value>
 ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> const & value,
                                 void * data);
 template <typename Key, typename Value>
+ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> && value,
+                                void * data);
+template <typename Key, typename Value>
 void ReflectionWrite(ReflectionHandle handle,
                      std::unordered_map<Key, Value> & value,
                      void * data);
@@ -125,6 +232,8 @@ template <typename Key, typename Value>
 ReflectionHandle ReflectionRead(std::map<Key, Value> const & value,
                                 void * data);
 template <typename Key, typename Value>
+ReflectionHandle ReflectionRead(std::map<Key, Value> && value, void * data);
+template <typename Key, typename Value>
 void ReflectionWrite(ReflectionHandle handle,
                      std::map<Key, Value> & value,
                      void * data);
@@ -159,6 +268,85 @@ void ReflectionUpdate(ReflectionHandle handle __attribute__((unused)),
 // Return nil, none, zero, nullptr whatever you call nothing
 ReflectionHandle ReflectionNil(void * data);
 
+// Is the last of Args a non-const lvalue ?
+template <typename... Args>
+struct ScriptResultArgument
+{
+  static const bool value = false;
+};
+
+template <typename Last>
+struct ScriptResultArgument<Last>
+{
+  static const bool value =
+    std::is_lvalue_reference<Last>::value &&
+    !std::is_const<typename std::remove_reference<Last>::type>::value;
+};
+
+template <typename First, typename Second, typename... Rest>
+struct ScriptResultArgument<First, Second, Rest...>
+  : public ScriptResultArgument<Second, Rest...>
+{
+};
+
+// The arguments of a call from C++ into a script (ScriptInterface::callRuby,
+// callPython, ScriptObject::call), converted to script values.
+// Args are deduced from forwarding references : when the last argument is a
+// non-const lvalue, it receives the return value of the script function.
+template <typename... Args>
+class ScriptCall
+{
+public:
+  static const bool hasResult = ScriptResultArgument<Args...>::value;
+  static const unsigned int numArguments = sizeof...(Args) - (hasResult ? 1 : 0);
+  static_assert(numArguments <= Reflection::maxArguments,
+                "Too many arguments, see Reflection::maxArguments");
+
+  ScriptCall(void * language, Args & ... args)
+    : arguments_(args...)
+    {
+      read(language, std::make_index_sequence<numArguments>());
+    }
+
+  const ReflectionHandle * handles() const { return handles_; }
+
+  // Convert the result of the script function into the result argument
+  void writeResult(ReflectionHandle result, void * language)
+    {
+      writeResult(result, language, std::integral_constant<bool, hasResult>());
+    }
+
+private:
+  // Arguments are read as const : a non-const container would be wrapped
+  // in a script object aliasing the caller's storage
+  template <std::size_t I>
+  using ConstArgument =
+    const typename std::remove_reference<
+      typename std::tuple_element<I, std::tuple<Args...> >::type>::type &;
+
+  template <std::size_t... I>
+  void read(void * language, std::index_sequence<I...>)
+    {
+      (void)std::initializer_list<int>
+        { 0, (handles_[I] =
+                ReflectionRead(static_cast<ConstArgument<I> >(
+                                 std::get<I>(arguments_)),
+                               language), 0)... };
+    }
+
+  void writeResult(ReflectionHandle result __attribute__((unused)),
+                   void * language __attribute__((unused)),
+                   std::false_type) {}
+  void writeResult(ReflectionHandle result, void * language, std::true_type)
+    {
+      ReflectionWrite(result, std::get<sizeof...(Args) - 1>(arguments_),
+                      language);
+    }
+
+  std::tuple<Args & ...> arguments_;
+  ReflectionHandle handles_[numArguments + 1]; // no zero sized arrays
+};
+
 // static type checking for exported classes
 template <typename T>
 void ReflectionCheckType();
@@ -168,15 +356,14 @@ ReflectionClassInfo * ReflectionMakeClassInfo();
 
 #include "ScriptObject.h"
 #include "ScriptCppArray.h"
+#include "ScriptCppBuffer.h"
+#include "ScriptCppArrayView.h"
 
 //////////////////
 // Common stuff //
 //////////////////
 Reflection::ClassBase * Reflection_Registry_getClass(const std::string & name);
 
-inline void ReflectionWrite(ReflectionHandle handle __attribute__((unused)),
-                            Reflection::NoClass & value __attribute__((unused)),
-                            void * data __attribute__((unused))) {}
 // Static type check that can be done on a reflected class
 template <typename T>
 void ReflectionCheckType()
@@ -193,7 +380,7 @@ void * ReflectionMakeReference(void * self)
 {
   if (self == nullptr)
     throw std::runtime_error("self is 0");
-  return new RubyPythonReference(new ConcretePointer<T>((T*)self, false));
+  return RubyPythonReference::create<ConcretePointer<T> >((T*)self, false);
 }
 
 template<typename T, bool isDerivedFromScriptObject>
@@ -237,6 +424,8 @@ struct PythonReflectionInstance
 {
   PyObject_HEAD
   RubyPythonReference * reference;
+  // reference->getObject(), so a call needs only one load to find self
+  void * object;
 };
 
 // The struct that will be used for each class
@@ -248,96 +437,118 @@ struct PythonClassBase
 
 // Implemented in ScriptInterface.C
 PythonClassBase * isPythonClassBase(PyTypeObject * arg);
+
+// Implemented in ReflectionImplement.C
+// The UTF-8 buffer of a python string, owned by value
+void pythonStringBuffer(PyObject * value, const char * & buffer,
+                        Py_ssize_t & length);
+// Make the empty python list size items long.  The items are nullptr and
+// must all be set with PyList_SET_ITEM.
+void resizePythonList(PyObject * list, size_t size);
+// Empty a list, also one not completely filled after resizePythonList.  The
+// python error indicator is left alone.
+void clearPythonList(PyObject * list);
 #endif
 
-//////////////////////////////////////////////////////
-// Implementation of reflection for Ruby and Python //
-//////////////////////////////////////////////////////
-// vectors of something convertable
-template <typename T>
-ReflectionHandle ReflectionRead(std::vector<T> & value, void * data)
+#if __cplusplus >= 201703L
+ReflectionHandle ReflectionRead(std::string_view value, void * data)
 {
   ReflectionHandle result;
 #ifdef SCRIPT_RUBY
   if (data == LANGUAGE_RUBY)
-    {
-      result.rubyHandle = (new ScriptCppArray<T>(&value, data))->rubyHandle_;
-      for (auto element : value)
-        {
-          rb_ary_push(result.rubyHandle,
-                      ReflectionRead(element, LANGUAGE_RUBY).rubyHandle);
-        }
-    }
+    result.rubyHandle = rb_utf8_str_new(value.data(), value.size());
 #endif
 #ifdef SCRIPT_PYTHON
   if (data == LANGUAGE_PYTHON)
-    {
-      result.pythonHandle =
-        (PyObject*)(new ScriptCppArray<T>(&value, data))->pythonHandle_;
-      for (auto element : value)
-        {
-          if (PyList_Append(result.pythonHandle,
-                            ReflectionRead(element, data).pythonHandle) < 0)
-            PythonException::checkPythonException();
-        }
-    }
+#if PY_MAJOR_VERSION == 2
+    result.pythonHandle = PyString_FromStringAndSize(value.data(),
+                                                     value.size());
+#endif
+#if PY_MAJOR_VERSION == 3
+    result.pythonHandle = PyUnicode_FromStringAndSize(value.data(),
+                                                      value.size());
+#endif
 #endif
   return result;
 }
 
-template <typename T>
-ReflectionHandle ReflectionRead(const std::vector<T> & value, void * data)
+void ReflectionWrite(ReflectionHandle handle, std::string_view & value,
+                     void * data)
 {
-  ReflectionHandle result;
 #ifdef SCRIPT_RUBY
   if (data == LANGUAGE_RUBY)
     {
-      result.rubyHandle = (new ScriptCppArray<T>(nullptr, data))->rubyHandle_;
-      for (auto element : value)
+      if (TYPE(handle.rubyHandle) != T_STRING)
         {
-          rb_ary_push(result.rubyHandle,
-                      ReflectionRead(element, LANGUAGE_RUBY).rubyHandle);
+          throw std::runtime_error("argument is not of type String, class is " +
+                                   ScriptObject::
+                                   getRubyClassname(handle.rubyHandle));
         }
+      value = std::string_view(RSTRING_PTR(handle.rubyHandle),
+                               RSTRING_LEN(handle.rubyHandle));
     }
 #endif
 #ifdef SCRIPT_PYTHON
   if (data == LANGUAGE_PYTHON)
     {
-      result.pythonHandle =
-        (PyObject*)(new ScriptCppArray<T>(nullptr, data))->pythonHandle_;
-      for (auto element : value)
-        {
-          if (PyList_Append(result.pythonHandle,
-                            ReflectionRead(element, data).pythonHandle) < 0)
-            PythonException::checkPythonException();
-        }
+      const char * buffer;
+      Py_ssize_t length;
+      pythonStringBuffer(handle.pythonHandle, buffer, length);
+      value = std::string_view(buffer, length);
     }
 #endif
-  return result;
 }
+#endif
 
-template <typename T>
-void ReflectionUpdate(ReflectionHandle handle, std::vector<T> & value,
-                      void * data)
+//////////////////////////////////////////////////////
+// Implementation of reflection for Ruby and Python //
+//////////////////////////////////////////////////////
+// Fill the script array with size converted elements.  It is resized once
+// and the elements are stored in place.  Ruby arrays may hold the previous
+// value (ReflectionUpdate), python lists are always new.
+template <typename Iterator>
+void ReflectionReadElements(ReflectionHandle array, Iterator element,
+                            size_t size, void * data)
 {
 #ifdef SCRIPT_RUBY
-  // TODO check script type of handle is array
-  // TODO maybe also check that it is a ScriptCppArray ?
   if (data == LANGUAGE_RUBY)
     {
-      rb_ary_clear(handle.rubyHandle);
-      for (auto element : value)
+      VALUE items = array.rubyHandle;
+      rb_ary_resize(items, size);
+      for (size_t item=0; item<size; ++item, ++element)
         {
-          rb_ary_push(handle.rubyHandle,
-                      ReflectionRead(element, LANGUAGE_RUBY).rubyHandle);
+          rb_ary_store(items, item, ReflectionRead(*element, data).rubyHandle);
+        }
+    }
+#endif
+#ifdef SCRIPT_PYTHON
+  if (data == LANGUAGE_PYTHON)
+    {
+      PyObject * items = array.pythonHandle;
+      resizePythonList(items, size);
+      try
+        {
+          for (size_t item=0; item<size; ++item, ++element)
+            {
+              PyObject * pyElement = ReflectionRead(*element, data).pythonHandle;
+              if (pyElement == nullptr)
+                PythonException::checkPythonException();
+              PyList_SET_ITEM(items, item, pyElement);
+            }
+        }
+      catch (...)
+        {
+          clearPythonList(items);
+          throw;
         }
     }
 #endif
 }
 
+// Convert a script array (Ruby array, Python sequence) to value
 template <typename T>
-void ReflectionWrite(ReflectionHandle handle, std::vector<T> & value,
-                     void * data)
+void ReflectionWriteElements(ReflectionHandle handle, std::vector<T> & value,
+                             void * data)
 {
 #ifdef SCRIPT_RUBY
   if (data == LANGUAGE_RUBY)
@@ -349,26 +560,24 @@ void ReflectionWrite(ReflectionHandle handle, std::vector<T> & value,
                                    getRubyClassname(handle.rubyHandle));
         }
       value.clear();
-      for (int item=0; item<RARRAY_LEN(handle.rubyHandle); ++item)
+      value.reserve(RARRAY_LEN(handle.rubyHandle));
+      // The conversion can run ruby code, so the array is indexed again for
+      // each element
+      long item = 0;
+      try
         {
-          T element;
-          ReflectionHandle rubyElement;
-          rubyElement.rubyHandle = RARRAY_PTR(handle.rubyHandle)[item];
-          try
+          for (; item<RARRAY_LEN(handle.rubyHandle); ++item)
             {
+              T element;
+              ReflectionHandle rubyElement;
+              rubyElement.rubyHandle = RARRAY_AREF(handle.rubyHandle, item);
               ReflectionWrite(rubyElement, element, data);
+              value.push_back(std::move(element));
             }
-          catch (std::exception & e)
-            {
-              char number[8];
-              snprintf(number, 8, "%d", item);
-              throw std::runtime_error("When converting element " +
-                                       std::string(number) + " to a C++ "
-                                       "array of " +
-                                       niceTypename(typeid(T).name()) + "\n" +
-                                       e.what());
-            }
-          value.push_back(element);
+        }
+      catch (std::exception & e)
+        {
+          throw arrayElementError(item, typeid(T).name(), e);
         }
     }
 #endif
@@ -379,33 +588,206 @@ void ReflectionWrite(ReflectionHandle handle, std::vector<T> & value,
         {
           throw std::runtime_error("argument is not a sequence");
         }
+      PyObject * sequence = PySequence_Fast(handle.pythonHandle,
+                                            "argument is not a sequence");
+      if (sequence == nullptr)
+        PythonException::checkPythonException();
+      Py_ssize_t length = PySequence_Fast_GET_SIZE(sequence);
+      PyObject ** items = PySequence_Fast_ITEMS(sequence);
       value.clear();
-      unsigned int length = PySequence_Length(handle.pythonHandle);
-      for (unsigned int item=0; item<length; ++item)
+      value.reserve(length);
+      Py_ssize_t item = 0;
+      try
         {
-          T element;
-          ReflectionHandle pyItem;
-          pyItem.pythonHandle = PySequence_GetItem(handle.pythonHandle, item);
-          if (pyItem.pythonHandle == nullptr)
-            {
-              throw std::runtime_error("Can't get sequence item");
-            }
-          try
+          for (; item<length; ++item)
             {
+              T element;
+              ReflectionHandle pyItem;
+              pyItem.pythonHandle = items[item];
               ReflectionWrite(pyItem, element, data);
+              value.push_back(std::move(element));
             }
-          catch (std::exception & e)
-            {
-              throw std::runtime_error("When converting elements to a C++ "
-                                       "array of " +
-                                       niceTypename(typeid(T).name()) + "\n" +
-                                       e.what());
-            }
-          Py_DECREF(pyItem.pythonHandle);
-          value.push_back(element);
         }
+      catch (std::exception & e)
+        {
+          Py_DECREF(sequence);
+          throw arrayElementError(item, typeid(T).name(), e);
+        }
+      Py_DECREF(sequence);
+    }
+#endif
+}
+
+// Copy packed numbers (Python buffer, Ruby binary string) into value, see
+// ScriptCppBuffer.  Returns false if handle can't be copied as a whole.
+template <typename T>
+typename std::enable_if<std::is_arithmetic<T>::value &&
+                        !std::is_same<T, bool>::value, bool>::type
+ReflectionWritePacked(ReflectionHandle handle, std::vector<T> & value,
+                      void * data)
+{
+  return ScriptCppBuffer<T>(&value).writePacked(handle, data);
+}
+
+template <typename T>
+typename std::enable_if<!std::is_arithmetic<T>::value ||
+                        std::is_same<T, bool>::value, bool>::type
+ReflectionWritePacked(ReflectionHandle handle __attribute__((unused)),
+                      std::vector<T> & value __attribute__((unused)),
+                      void * data __attribute__((unused)))
+{
+  return false;
+}
+
+// Whole array conversion, see the specializations for double, int and
+// std::string below
+template <typename T>
+struct ReflectionArray
+{
+  static void read(ReflectionHandle array, const std::vector<T> & value,
+                   void * data)
+    { ReflectionReadElements(array, value.begin(), value.size(), data); }
+  static void read(ReflectionHandle array, std::vector<T> && value,
+                   void * data)
+    {
+      ReflectionReadElements(array, std::make_move_iterator(value.begin()),
+                             value.size(), data);
     }
+  static void write(ReflectionHandle handle, std::vector<T> & value,
+                    void * data)
+    {
+      if (!ReflectionWritePacked(handle, value, data))
+        ReflectionWriteElements(handle, value, data);
+    }
+};
+
+// The common arrays of numbers and strings are converted in a tight loop,
+// without a function call per element.  Elements the loop doesn't handle
+// itself make it fall back to ReflectionWriteElements, which also gives the
+// error message.
+// Implemented in ReflectionImplement.C
+template <>
+struct ReflectionArray<double>
+{
+  static void read(ReflectionHandle array, const std::vector<double> & value,
+                   void * data);
+  static void write(ReflectionHandle handle, std::vector<double> & value,
+                    void * data);
+};
+
+template <>
+struct ReflectionArray<int>
+{
+  static void read(ReflectionHandle array, const std::vector<int> & value,
+                   void * data);
+  static void write(ReflectionHandle handle, std::vector<int> & value,
+                    void * data);
+};
+
+template <>
+struct ReflectionArray<std::string>
+{
+  static void read(ReflectionHandle array,
+                   const std::vector<std::string> & value, void * data);
+  static void write(ReflectionHandle handle, std::vector<std::string> & value,
+                    void * data);
+};
+
+// vectors of something convertable
+template <typename T>
+ReflectionHandle ReflectionRead(std::vector<T> & value, void * data)
+{
+  ReflectionHandle result;
+#ifdef SCRIPT_RUBY
+  if (data == LANGUAGE_RUBY)
+    result.rubyHandle = (new ScriptCppArray<T>(&value, data))->rubyHandle_;
+#endif
+#ifdef SCRIPT_PYTHON
+  if (data == LANGUAGE_PYTHON)
+    result.pythonHandle =
+      (PyObject*)(new ScriptCppArray<T>(&value, data))->pythonHandle_;
+#endif
+  ReflectionArray<T>::read(result, value, data);
+  return result;
+}
+
+template <typename T>
+ReflectionHandle ReflectionRead(const std::vector<T> & value, void * data)
+{
+  ReflectionHandle result;
+#ifdef SCRIPT_RUBY
+  if (data == LANGUAGE_RUBY)
+    result.rubyHandle = (new ScriptCppArray<T>(nullptr, data))->rubyHandle_;
 #endif
+#ifdef SCRIPT_PYTHON
+  if (data == LANGUAGE_PYTHON)
+    result.pythonHandle =
+      (PyObject*)(new ScriptCppArray<T>(nullptr, data))->pythonHandle_;
+#endif
+  ReflectionArray<T>::read(result, value, data);
+  return result;
+}
+
+template <typename T>
+ReflectionHandle ReflectionRead(std::vector<T> && value, void * data)
+{
+  ReflectionHandle result;
+#ifdef SCRIPT_RUBY
+  if (data == LANGUAGE_RUBY)
+    result.rubyHandle = (new ScriptCppArray<T>(nullptr, data))->rubyHandle_;
+#endif
+#ifdef SCRIPT_PYTHON
+  if (data == LANGUAGE_PYTHON)
+    result.pythonHandle =
+      (PyObject*)(new ScriptCppArray<T>(nullptr, data))->pythonHandle_;
+#endif
+  ReflectionArray<T>::read(result, std::move(value), data);
+  return result;
+}
+
+template <typename T>
+void ReflectionUpdate(ReflectionHandle handle, std::vector<T> & value,
+                      void * data)
+{
+#ifdef SCRIPT_RUBY
+  // TODO check script type of handle is array
+  // TODO maybe also check that it is a ScriptCppArray ?
+  if (data == LANGUAGE_RUBY)
+    {
+      ReflectionArray<T>::read(handle, value, data);
+    }
+#endif
+}
+
+template <typename T>
+void ReflectionWrite(ReflectionHandle handle, std::vector<T> & value,
+                     void * data)
+{
+  ReflectionArray<T>::write(handle, value, data);
+}
+
+template <typename T>
+ReflectionHandle ReflectionReadBuffer(std::vector<T> & value, void * data,
+                                      ReflectionHandle owner
+                                        __attribute__((unused)))
+{
+#ifdef SCRIPT_PYTHON
+  if (data == LANGUAGE_PYTHON)
+    {
+      ReflectionHandle result;
+      result.pythonHandle =
+        (new ScriptCppBuffer<T>(&value))->makePythonView(owner.pythonHandle);
+      return result;
+    }
+#endif
+  return ReflectionRead(value, data);
+}
+
+template <typename T>
+ReflectionHandle ReflectionReadView(std::vector<T> & value, void * data,
+                                    ReflectionHandle owner)
+{
+  return (new ScriptCppArrayView<T>(&value, owner, data))->makeScriptObject();
 }
 
 // Deques
@@ -417,7 +799,7 @@ ReflectionHandle ReflectionRead(std::deque<T> & value, void * data)
   if (data == LANGUAGE_RUBY)
     {
       result.rubyHandle = (new ScriptCppArray<T>(&value, data))->rubyHandle_;
-      for (auto element : value)
+      for (const auto & element : value)
         {
           rb_ary_push(result.rubyHandle,
                       ReflectionRead(element, LANGUAGE_RUBY).rubyHandle);
@@ -429,7 +811,7 @@ ReflectionHandle ReflectionRead(std::deque<T> & value, void * data)
     {
       result.pythonHandle =
         (PyObject*)(new ScriptCppArray<T>(&value, data))->pythonHandle_;
-      for (auto element : value)
+      for (const auto & element : value)
         {
           if (PyList_Append(result.pythonHandle,
                             ReflectionRead(element, data).pythonHandle) < 0)
@@ -448,7 +830,7 @@ ReflectionHandle ReflectionRead(const std::deque<T> & value, void * data)
   if (data == LANGUAGE_RUBY)
     {
       result.rubyHandle = (new ScriptCppArray<T>(nullptr, data))->rubyHandle_;
-      for (auto element : value)
+      for (const auto & element : value)
         {
           rb_ary_push(result.rubyHandle,
                       ReflectionRead(element, LANGUAGE_RUBY).rubyHandle);
@@ -460,7 +842,7 @@ ReflectionHandle ReflectionRead(const std::deque<T> & value, void * data)
     {
       result.pythonHandle =
         (PyObject*)(new ScriptCppArray<T>(nullptr, data))->pythonHandle_;
-      for (auto element : value)
+      for (const auto & element : value)
         {
           if (PyList_Append(result.pythonHandle,
                             ReflectionRead(element, data).pythonHandle) < 0)
@@ -471,6 +853,39 @@ ReflectionHandle ReflectionRead(const std::deque<T> & value, void * data)
   return result;
 }
 
+template <typename T>
+ReflectionHandle ReflectionRead(std::deque<T> && value, void * data)
+{
+  ReflectionHandle result;
+#ifdef SCRIPT_RUBY
+  if (data == LANGUAGE_RUBY)
+    {
+      result.rubyHandle = (new ScriptCppArray<T>(nullptr, data))->rubyHandle_;
+      for (auto & element : value)
+        {
+          rb_ary_push(result.rubyHandle,
+                      ReflectionRead(std::move(element),
+                                     LANGUAGE_RUBY).rubyHandle);
+        }
+    }
+#endif
+#ifdef SCRIPT_PYTHON
+  if (data == LANGUAGE_PYTHON)
+    {
+      result.pythonHandle =
+        (PyObject*)(new ScriptCppArray<T>(nullptr, data))->pythonHandle_;
+      for (auto & element : value)
+        {
+          if (PyList_Append(result.pythonHandle,
+                            ReflectionRead(std::move(element),
+                                           data).pythonHandle) < 0)
+            PythonException::checkPythonException();
+        }
+    }
+#endif
+  return result;
+}
+
 template <typename T>
 void ReflectionWrite(ReflectionHandle handle, std::deque<T> & value,
                      void * data)
@@ -544,51 +959,203 @@ void ReflectionWrite(ReflectionHandle handle, std::deque<T> & value,
 #endif
 }
 
-// Hashes
-template <typename Key, typename Value>
-ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> & value,
-                                void * data)
+// Hashes and maps
+// Fill a new ruby hash or python dict with the entries of value.  Values
+// are moved out of temporaries, keys are always copied.
+template <typename Map>
+ReflectionHandle ReflectionReadMap(Map && value, void * data)
 {
+  typedef typename std::remove_reference<Map>::type::mapped_type Value;
+  typedef typename std::conditional<std::is_lvalue_reference<Map>::value,
+                                    const Value &, Value &&>::type ValueRef;
   ReflectionHandle result;
 #ifdef SCRIPT_RUBY
   if (data == LANGUAGE_RUBY)
     {
-      result.rubyHandle = rb_hash_new();
-      for (auto element : value)
+      result.rubyHandle = newRubyHash(value.size());
+      for (auto & element : value)
         {
           rb_hash_aset(result.rubyHandle,
-                       ReflectionRead(element.first, LANGUAGE_RUBY).rubyHandle,
-                       ReflectionRead(element.second, LANGUAGE_RUBY).rubyHandle);
+                       ReflectionRead(element.first, data).rubyHandle,
+                       ReflectionRead(static_cast<ValueRef>(element.second),
+                                      data).rubyHandle);
         }
     }
 #endif
 #ifdef SCRIPT_PYTHON
-  throw std::runtime_error("Not yet implemented");
+  if (data == LANGUAGE_PYTHON)
+    {
+      result.pythonHandle = PyDict_New();
+      if (result.pythonHandle == nullptr)
+        PythonException::checkPythonException();
+      try
+        {
+          for (auto & element : value)
+            {
+              PyObject * key = ReflectionRead(element.first,
+                                              data).pythonHandle;
+              if (key == nullptr)
+                PythonException::checkPythonException();
+              PyObject * item =
+                ReflectionRead(static_cast<ValueRef>(element.second),
+                               data).pythonHandle;
+              if (item == nullptr)
+                {
+                  Py_DECREF(key);
+                  PythonException::checkPythonException();
+                }
+              int error = PyDict_SetItem(result.pythonHandle, key, item);
+              Py_DECREF(key);
+              Py_DECREF(item);
+              if (error < 0)
+                PythonException::checkPythonException();
+            }
+        }
+      catch (...)
+        {
+          Py_DECREF(result.pythonHandle);
+          throw;
+        }
+    }
 #endif
   return result;
 }
 
 template <typename Key, typename Value>
-ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> const & value,
-                                void * data)
+void ReflectionReserve(std::unordered_map<Key, Value> & value, size_t size)
+{
+  value.reserve(size);
+}
+
+template <typename Key, typename Value>
+void ReflectionReserve(std::map<Key, Value> & value __attribute__((unused)),
+                       size_t size __attribute__((unused)))
+{
+}
+
+// Convert one entry of a script hash and add it to value
+template <typename Map>
+void ReflectionWriteMapEntry(ReflectionHandle key, ReflectionHandle item,
+                             Map & value, void * data)
+{
+  typename Map::key_type cppKey;
+  typename Map::mapped_type cppItem;
+  try
+    {
+      ReflectionWrite(key, cppKey, data);
+      ReflectionWrite(item, cppItem, data);
+    }
+  catch (std::exception & e)
+    {
+      throw mapEntryError(typeid(typename Map::key_type).name(),
+                          typeid(typename Map::mapped_type).name(), e);
+    }
+  value[std::move(cppKey)] = std::move(cppItem);
+}
+
+#ifdef SCRIPT_RUBY
+template <typename Map>
+struct RubyHashWriter
+{
+  Map * value;
+  std::exception_ptr error;
+};
+
+// rb_hash_foreach callback.  C++ exceptions must not unwind through ruby, so
+// they stop the iteration and are thrown again afterwards.
+template <typename Map>
+int ReflectionWriteRubyHashEntry(VALUE key, VALUE item, VALUE writerArg)
+{
+  auto writer = reinterpret_cast<RubyHashWriter<Map>*>(writerArg);
+  try
+    {
+      ReflectionHandle rubyKey, rubyItem;
+      rubyKey.rubyHandle = key;
+      rubyItem.rubyHandle = item;
+      ReflectionWriteMapEntry(rubyKey, rubyItem, *writer->value,
+                              LANGUAGE_RUBY);
+    }
+  catch (...)
+    {
+      writer->error = std::current_exception();
+      return ST_STOP;
+    }
+  return ST_CONTINUE;
+}
+#endif
+
+// Convert a script hash (Ruby hash, Python dict) to value
+template <typename Map>
+void ReflectionWriteMap(ReflectionHandle handle, Map & value, void * data)
 {
-  ReflectionHandle result;
 #ifdef SCRIPT_RUBY
   if (data == LANGUAGE_RUBY)
     {
-      result.rubyHandle = rb_hash_new();
-      for (auto element : value)
+      if (TYPE(handle.rubyHandle) != T_HASH)
         {
-          rb_hash_aset(result.rubyHandle,
-                       ReflectionRead(element.first, LANGUAGE_RUBY).rubyHandle,
-                       ReflectionRead(element.second, LANGUAGE_RUBY).rubyHandle);
+          throw std::runtime_error("expected type hash, got type " +
+                                   ScriptObject::
+                                   getRubyClassname(handle.rubyHandle));
         }
+      value.clear();
+      ReflectionReserve(value, RHASH_SIZE(handle.rubyHandle));
+      RubyHashWriter<Map> writer = { &value, nullptr };
+      rb_hash_foreach(handle.rubyHandle, &ReflectionWriteRubyHashEntry<Map>,
+                      (VALUE)&writer);
+      if (writer.error)
+        std::rethrow_exception(writer.error);
     }
 #endif
 #ifdef SCRIPT_PYTHON
-  throw std::runtime_error("Not yet implemented");
+  if (data == LANGUAGE_PYTHON)
+    {
+      if (!PyDict_Check(handle.pythonHandle))
+        {
+          throw std::runtime_error("argument is not a dict");
+        }
+      value.clear();
+      ReflectionReserve(value, PyDict_Size(handle.pythonHandle));
+      // The conversion can run python code, keep the dict alive meanwhile
+      Py_INCREF(handle.pythonHandle);
+      try
+        {
+          Py_ssize_t position = 0;
+          ReflectionHandle key, item;
+          while (PyDict_Next(handle.pythonHandle, &position,
+                             &key.pythonHandle, &item.pythonHandle))
+            {
+              ReflectionWriteMapEntry(key, item, value, data);
+            }
+        }
+      catch (...)
+        {
+          Py_DECREF(handle.pythonHandle);
+          throw;
+        }
+      Py_DECREF(handle.pythonHandle);
+    }
 #endif
-  return result;
+}
+
+template <typename Key, typename Value>
+ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> & value,
+                                void * data)
+{
+  return ReflectionReadMap(value, data);
+}
+
+template <typename Key, typename Value>
+ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> const & value,
+                                void * data)
+{
+  return ReflectionReadMap(value, data);
+}
+
+template <typename Key, typename Value>
+ReflectionHandle ReflectionRead(std::unordered_map<Key, Value> && value,
+                                void * data)
+{
+  return ReflectionReadMap(std::move(value), data);
 }
 
 template <typename Key, typename Value>
@@ -596,56 +1163,26 @@ void ReflectionWrite(ReflectionHandle handle,
                      std::unordered_map<Key, Value> & value,
                      void * data)
 {
-  // rb_hash_foreach
-  throw std::runtime_error("Not yet implemented");
+  ReflectionWriteMap(handle, value, data);
 }
 
-// Map
 template <typename Key, typename Value>
 ReflectionHandle ReflectionRead(std::map<Key, Value> & value, void * data)
 {
-  ReflectionHandle result;
-#ifdef SCRIPT_RUBY
-  if (data == LANGUAGE_RUBY)
-    {
-      result.rubyHandle = rb_hash_new();
-      for (auto element : value)
-        {
-          rb_hash_aset(result.rubyHandle,
-                       ReflectionRead(element.first, LANGUAGE_RUBY).rubyHandle,
-                       ReflectionRead(element.second,
-                                      LANGUAGE_RUBY).rubyHandle);
-        }
-    }
-#endif
-#ifdef SCRIPT_PYTHON
-  throw std::runtime_error("Not yet implemented");
-#endif
-  return result;
+  return ReflectionReadMap(value, data);
 }
 
 template <typename Key, typename Value>
 ReflectionHandle ReflectionRead(std::map<Key, Value> const & value,
                                 void * data)
 {
-  ReflectionHandle result;
-#ifdef SCRIPT_RUBY
-  if (data == LANGUAGE_RUBY)
-    {
-      result.rubyHandle = rb_hash_new();
-      for (auto element : value)
-        {
-          rb_hash_aset(result.rubyHandle,
-                       ReflectionRead(element.first, LANGUAGE_RUBY).rubyHandle,
-                       ReflectionRead(element.second,
-                                      LANGUAGE_RUBY).rubyHandle);
-        }
-    }
-#endif
-#ifdef SCRIPT_PYTHON
-  throw std::runtime_error("Not yet implemented");
-#endif
-  return result;
+  return ReflectionReadMap(value, data);
+}
+
+template <typename Key, typename Value>
+ReflectionHandle ReflectionRead(std::map<Key, Value> && value, void * data)
+{
+  return ReflectionReadMap(std::move(value), data);
 }
 
 template <typename Key, typename Value>
@@ -653,7 +1190,7 @@ void ReflectionWrite(ReflectionHandle handle,
                      std::map<Key, Value> & value,
                      void * data)
 {
-  throw std::runtime_error("Not yet implemented");
+  ReflectionWriteMap(handle, value, data);
 }
 
 // Exported classes conversion
@@ -688,8 +1225,8 @@ ReflectionHandle ReflectionRead(T * self, void * data)
                                      " is not a script-exported class");
 
           instance = rb_obj_alloc(klass->getClassInfo()->rubyClass);
-          DATA_PTR(instance) = ref;
-          ref->setRubyObject(instance);
+          RTYPEDDATA_DATA(instance) = ref;
+          ref->setRubyObject(instance, klass);
         }
       // else reuse previously created instance
       result.rubyHandle = instance;
@@ -710,10 +1247,12 @@ ReflectionHandle ReflectionRead(T * self, void * data)
                                      " is not a script-exported class");
 
           PythonReflectionInstance * pyInstance =
-            PyObject_New(PythonReflectionInstance,
-                         klass->getClassInfo()->pythonClass);
+            PyObject_GC_New(PythonReflectionInstance,
+                            klass->getClassInfo()->pythonClass);
           pyInstance->reference = ref;
+          pyInstance->object = ref->getObject();
           instance = (PyObject*)pyInstance;
+          PyObject_GC_Track(instance);
           ref->setPyObject(instance);
           Py_INCREF(instance); // for C++ version
         }
@@ -739,6 +1278,39 @@ ReflectionHandle ReflectionRead(const T & self, void * data)
   return result;
 }
 
+// An exported object the script refers to without owning it, e.g. a member
+// of another object : the script object neither keeps it alive nor deletes
+// it.  See Reflection::ReturnPolicy::reference.
+template <typename T>
+ReflectionHandle ReflectionReadBorrowed(T * self, void * data)
+{
+  if (self == nullptr)
+    return ReflectionNil(data);
+  ReflectionCheckType<T>();
+  ScriptAccess * selfBase = self;
+  if (selfBase->getReference())
+    return ReflectionRead(self, data); // Already known to the script
+  selfBase->setReference(ScriptReferenceFactory::instance().make<T>(self, false,
+                                                                    true));
+  ReflectionHandle result = ReflectionRead(self, data);
+  selfBase->getReference()->deleteFromC(); // C++ doesn't use the reference
+  return result;
+}
+
+// A temporary exported class, moved into the script object
+template <typename T>
+typename std::enable_if<!std::is_reference<T>::value &&
+                        std::is_base_of<ScriptAccess, T>::value,
+                        ReflectionHandle>::type
+ReflectionRead(T && self, void * data)
+{
+  T * selfCopy = new T(std::move(self));
+
+  ReflectionHandle result = ReflectionRead(selfCopy, data);
+  selfCopy->deleteFromC(); // So the scripting language can delete it
+  return result;
+}
+
 template <typename T>
 void ReflectionUpdate(ReflectionHandle handle __attribute__((unused)),
                       T * self __attribute__((unused)),
@@ -747,18 +1319,19 @@ void ReflectionUpdate(ReflectionHandle handle __attribute__((unused)),
   throw std::runtime_error("Not yet implemented");
 }
 
+// The reference of the C++ object wrapped by handle, or nullptr for nil
 template <typename T>
-void ReflectionWrite(ReflectionHandle handle, T * & value, void * data)
+RubyPythonReference * ReflectionWrappedReference(ReflectionHandle handle,
+                                                 void * data)
 {
 #ifdef SCRIPT_RUBY
   if (data == LANGUAGE_RUBY)
     {
       if (TYPE(handle.rubyHandle) != T_DATA)
         {
-          value = nullptr;
           if (handle.rubyHandle == Qnil)
             { // allow ruby nil (null pointer)
-              return;
+              return nullptr;
             }
           // Not a data wrapped object
           throw std::runtime_error("Conversion from script to C++ failed\n"
@@ -768,36 +1341,23 @@ void ReflectionWrite(ReflectionHandle handle, T * & value, void * data)
                                    ScriptObject::
                                    getRubyClassname(handle.rubyHandle));
         }
-      VALUE rbParent = CLASS_OF(handle.rubyHandle);
-      VALUE cppKlass;
-      while (rbParent != Qnil)
-        {
-          cppKlass = rb_iv_get(rbParent, "@c++class");
-          if (cppKlass != Qnil)
-            {
-              break;
-            }
-          rbParent = RCLASS_SUPER(rbParent);
-        }
-      if (cppKlass == Qnil)
+      if (!rb_typeddata_is_kind_of(handle.rubyHandle, &rubyReferenceType))
         {
           // Not one of ours
-          value = 0;
           throw std::runtime_error("Conversion from script to C++ failed\n"
                                    "Got a C++ wrapped class NOT created by me");
         }
 
-      RubyPythonReference * reference;
-      Data_Get_Struct(handle.rubyHandle, RubyPythonReference, reference);
+      RubyPythonReference * reference =
+        static_cast<RubyPythonReference*>(RTYPEDDATA_DATA(handle.rubyHandle));
       if (!reference)
         {
           // Impossible ?
-          value = 0;
           throw std::runtime_error("Conversion from script to C++ failed\n"
                                    "The impossible has happened");
         }
-      value = reinterpret_cast<T*>(reference->getCppObject()->get());
-      reference->useInC();
+      checkCppObject(reference->getObject());
+      return reference;
     }
 #endif
 #ifdef SCRIPT_PYTHON
@@ -817,7 +1377,6 @@ void ReflectionWrite(ReflectionHandle handle, T * & value, void * data)
       if (pythonClass == nullptr)
         {
           // Not a C++ object
-          value = nullptr;
           throw std::runtime_error("Conversion from script to C++ failed\n"
                                    "Expected type " +
                                    niceTypename(typeid(T).name()) + "\n"
@@ -827,17 +1386,114 @@ void ReflectionWrite(ReflectionHandle handle, T * & value, void * data)
         }
       PythonReflectionInstance * instance =
         (PythonReflectionInstance*)handle.pythonHandle;
-      value = reinterpret_cast<T*>(instance->reference->getCppObject()->get());
-      instance->reference->useInC();
+      checkCppObject(instance->object);
+      return instance->reference;
     }
 #endif
+  return nullptr;
+}
+
+// The C++ object wrapped by handle, without marking it as used in C++.
+// Only valid while the script object is.
+template <typename T>
+T * ReflectionWrapped(ReflectionHandle handle, void * data)
+{
+  auto reference = ReflectionWrappedReference<T>(handle, data);
+  if (reference == nullptr)
+    return nullptr;
+  return reinterpret_cast<T*>(reference->getObject());
+}
+
+template <typename T>
+void ReflectionWrite(ReflectionHandle handle, T * & value, void * data)
+{
+  auto reference = ReflectionWrappedReference<T>(handle, data);
+  if (reference == nullptr)
+    {
+      value = nullptr;
+      return;
+    }
+  value = reinterpret_cast<T*>(reference->getObject());
+  reference->useInC();
+}
+
+template <typename T>
+ReflectionHandle ReflectionRead(const std::shared_ptr<T> & value, void * data)
+{
+  if (!value)
+    return ReflectionNil(data);
+  ReflectionCheckType<T>();
+  ScriptAccess * selfBase = value.get();
+  if (selfBase->getReference())
+    return ReflectionRead(value.get(), data); // Already known to the script
+  selfBase->setReference(ScriptReferenceFactory::instance().make<T>(value));
+  ReflectionHandle result = ReflectionRead(value.get(), data);
+  selfBase->getReference()->deleteFromC(); // Owned by the script object
+  return result;
+}
+
+template <typename T>
+ReflectionHandle ReflectionRead(std::unique_ptr<T> && value, void * data)
+{
+  if (!value)
+    return ReflectionNil(data);
+  T * self = value.release();
+  ReflectionHandle result = ReflectionRead(self, data);
+  static_cast<ScriptAccess*>(self)->deleteFromC(); // Owned by the script
+  return result;
+}
+
+template <typename T>
+ReflectionHandle ReflectionRead(const std::unique_ptr<T> & value, void * data)
+{
+  return ReflectionReadBorrowed(value.get(), data);
+}
+
+template <typename T>
+void ReflectionWrite(ReflectionHandle handle, std::shared_ptr<T> & value,
+                     void * data)
+{
+  auto reference = ReflectionWrappedReference<T>(handle, data);
+  if (reference == nullptr)
+    {
+      value.reset();
+      return;
+    }
+  T * object = reinterpret_cast<T*>(reference->getObject());
+  std::shared_ptr<void> owner = reference->getCppObject()->getSharedPtr();
+  if (owner)
+    {
+      value = std::shared_ptr<T>(owner, object);
+      return;
+    }
+  // The script owns the object, the shared_ptrs keep its script object alive
+  reference->useInC();
+  value = std::shared_ptr<T>(object, [reference](T *)
+                                       { reference->deleteFromC(); });
+}
+
+template <typename T>
+void ReflectionWrite(ReflectionHandle handle, std::unique_ptr<T> & value,
+                     void * data)
+{
+  auto reference = ReflectionWrappedReference<T>(handle, data);
+  if (reference == nullptr)
+    {
+      value.reset();
+      return;
+    }
+  if (reference->isUsedInC())
+    throw std::runtime_error("Conversion from script to C++ failed\n"
+                             "Can't move a " + niceTypename(typeid(T).name()) +
+                             " used in C++ into a unique_ptr");
+  value.reset(reinterpret_cast<T*>(reference->releaseCppObject()));
 }
 
 template <typename T>
 void ReflectionWrite(ReflectionHandle handle, T & value, void * data)
 {
-  T * valuePtr = nullptr;
-  ReflectionWrite(handle, valuePtr, data);
+  // Copied, so the script object is not used in C++ afterwards
+  T * valuePtr = ReflectionWrapped<T>(handle, data);
   if (valuePtr == nullptr)
     throw std::runtime_error("Conversion from script to C++ failed\n"
                              "Got nil from script for a reference type in C++");
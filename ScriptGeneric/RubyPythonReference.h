@@ -19,14 +19,26 @@
 #include <Python.h>
 #endif
 #include "ScriptReference.h"
+#include "ScriptReferencePool.h"
+#include <new>
+#include <utility>
+#include <vector>
 #ifdef SCRIPT_RUBY
 #include <ruby.h>
 #endif
 
+namespace Reflection
+{
+class ClassBase;
+}
+
 class RubyPythonReference : public ScriptReference
 {
 public:
-  RubyPythonReference(AbstractPointer * cppObject);
+  // Create a reference owning a new Pointer (a ConcretePointer) constructed
+  // from args.  Both are allocated in one block from ScriptReferencePool.
+  template <typename Pointer, typename... Args>
+  static RubyPythonReference * create(Args && ... args);
 
   virtual void useInC() override;
 
@@ -34,24 +46,77 @@ public:
 
   virtual void deleteFromScript(void * data) override;
 
+  virtual void * releaseCppObject() override;
+
+  virtual void forgetCppObject() override;
+
+  // The block holding this reference and the C++ object it owns
+  size_t memsize() const;
+
 #ifdef SCRIPT_RUBY
   VALUE getRubyObject() const { return rubyObject_; }
-  void setRubyObject(VALUE rubyObject) { rubyObject_ = rubyObject; }
+  // rubyClass is the exported class of rubyObject, i.e.
+  // getCppKlassPointer(rb_obj_class(rubyObject))
+  void setRubyObject(VALUE rubyObject, Reflection::ClassBase * rubyClass)
+    {
+      rubyObject_ = rubyObject;
+      rubyClass_ = rubyClass;
+    }
+  Reflection::ClassBase * getRubyClass() const { return rubyClass_; }
 #endif
 #ifdef SCRIPT_PYTHON
   PyObject * getPyObject() const { return pyObject_; }
   void setPyObject(PyObject * pyObject) { pyObject_ = pyObject; }
+  // Keep patient alive as long as the python object of this reference
+  void keepAlive(PyObject * patient);
+  // tp_traverse/tp_clear of the python object : the kept alive patients and
+  // the ScriptObjects the C++ object reports (see ScriptObject.h) when it is
+  // owned by this reference alone
+  int traversePython(visitproc visit, void * arg) const;
+  void clearPython();
 #endif
 
 private:
+  RubyPythonReference(AbstractPointer * cppObject, size_t blockSize);
   ~RubyPythonReference();
+  // Instead of delete this
+  void destroy();
+
+  size_t blockSize_;
 
 #ifdef SCRIPT_RUBY
   VALUE rubyObject_;
+  Reflection::ClassBase * rubyClass_;
 #endif
 #ifdef SCRIPT_PYTHON
+  void releaseKeepAlive();
+
   PyObject * pyObject_;
+  std::vector<PyObject*> pyKeepAlive_;
 #endif
 };
 
+template <typename Pointer, typename... Args>
+RubyPythonReference * RubyPythonReference::create(Args && ... args)
+{
+  // The pointer follows the reference in the block
+  const size_t pointerOffset =
+    (sizeof(RubyPythonReference) + alignof(Pointer) - 1) /
+    alignof(Pointer) * alignof(Pointer);
+  const size_t blockSize = pointerOffset + sizeof(Pointer);
+  char * block = static_cast<char*>(ScriptReferencePool::allocate(blockSize));
+  Pointer * cppObject;
+  try
+    {
+      cppObject = ::new (block + pointerOffset)
+        Pointer(std::forward<Args>(args)...);
+    }
+  catch (...)
+    {
+      ScriptReferencePool::deallocate(block, blockSize);
+      throw;
+    }
+  return ::new (block) RubyPythonReference(cppObject, blockSize);
+}
+
 #endif
@@ -0,0 +1,66 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef RubyRootTable_h_
+#define RubyRootTable_h_
+
+#include <ruby.h>
+#include <cstddef>
+#include <vector>
+
+// The ruby objects used in C++, with a reference count per object.
+// Ruby objects can be used several times from C++, e.g. 2 exported classes A
+// and B, B is instantiated in A twice
+// class A { B * b_0; B * b_1; };
+// Then in Ruby
+// boo = B.new
+// aaa = A.new
+// aaa.b_0 = boo
+// aaa.b_1 = boo
+// Then the deletion of aaa will trigger the destructor of A which will call
+// boo->deleteFromC() twice.
+//
+// An open addressing hash table (linear probing) on the VALUE, so add and
+// remove don't allocate unless the table grows.  A single ruby object,
+// registered with rb_gc_register_mark_object, marks all objects in the table.
+class RubyRootTable
+{
+public:
+  RubyRootTable();
+
+  // Create the marking ruby object, once ruby is initialized
+  void init();
+  void add(VALUE object);
+  // Returns false if object is not in the table
+  bool remove(VALUE object);
+  size_t size() const { return size_; }
+
+  // Ruby 'garbage collect mark' of the marking object
+  static void mark(void * table);
+
+private:
+  struct Entry
+  {
+    VALUE object; // 0 for an empty entry
+    unsigned long count;
+  };
+
+  size_t slot(VALUE object) const;
+  void grow();
+
+  std::vector<Entry> entries_;
+  size_t size_;
+};
+
+#endif
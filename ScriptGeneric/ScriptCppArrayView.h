@@ -0,0 +1,75 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ScriptCppArrayView_h_
+#define ScriptCppArrayView_h_
+
+#include <cstddef>
+#include <vector>
+
+// Lazy view of a std::vector : unlike ScriptCppArray, the elements are not
+// copied into a script array.  Indexing, size/len and iteration convert
+// elements of the C++ vector when they are asked for, assigning an element
+// writes it into the vector.
+// The view keeps the script object owning the vector alive.
+class ScriptCppArrayViewBase
+{
+public:
+  ScriptCppArrayViewBase(ReflectionHandle owner, void * language);
+  virtual ~ScriptCppArrayViewBase();
+
+  static void init();
+
+  // New script object for this view, which becomes its owner
+  ReflectionHandle makeScriptObject();
+
+  virtual size_t length() const = 0;
+  virtual ReflectionHandle getElement(size_t index) = 0;
+  virtual void setElement(size_t index, ReflectionHandle value) = 0;
+
+  ReflectionHandle getOwner() const { return owner_; }
+protected:
+  ReflectionHandle owner_;
+  void * language_;
+#ifdef SCRIPT_RUBY
+  static VALUE rubyClassType_;
+#endif
+};
+
+template <typename T>
+class ScriptCppArrayView : public ScriptCppArrayViewBase
+{
+public:
+  ScriptCppArrayView(std::vector<T> * cppArray, ReflectionHandle owner,
+                     void * language)
+    : ScriptCppArrayViewBase(owner, language), cppArray_(cppArray)
+    {}
+
+  virtual size_t length() const override { return cppArray_->size(); }
+  virtual ReflectionHandle getElement(size_t index) override
+    {
+      const T & element = (*cppArray_)[index];
+      return ReflectionRead(element, language_);
+    }
+  virtual void setElement(size_t index, ReflectionHandle value) override
+    {
+      T element;
+      ReflectionWrite(value, element, language_);
+      (*cppArray_)[index] = std::move(element);
+    }
+private:
+  std::vector<T> * cppArray_;
+};
+
+#endif
@@ -0,0 +1,108 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ScriptCppBuffer_h_
+#define ScriptCppBuffer_h_
+
+#include <cstddef>
+#include <vector>
+
+// Zero-copy view of a std::vector of numbers.
+// Python gets an object supporting the buffer protocol, so memoryview() or
+// numpy.asarray() use the C++ elements directly.  The view keeps the Python
+// object owning the vector alive.  Once the vector is resized (and maybe
+// reallocated) the view is invalid : asking it for a buffer raises
+// BufferError, get the attribute again for a new view.  Note that buffers
+// handed out before the resize can't be revoked.
+// The other way around, packed numbers (a Python buffer or a Ruby binary
+// string) are copied into the vector in one go by writePacked.
+class ScriptCppBufferBase
+{
+public:
+  ScriptCppBufferBase(const char * format, size_t itemSize);
+  virtual ~ScriptCppBufferBase();
+
+  static void init();
+
+#ifdef SCRIPT_PYTHON
+  // New python view on this buffer, which becomes the owner of this
+  PyObject * makePythonView(PyObject * owner);
+#endif
+
+  // Copy the numbers packed in handle into the vector.  Returns false when
+  // handle isn't packed or holds other numbers, to convert it element by
+  // element instead.
+  bool writePacked(ReflectionHandle handle, void * language);
+
+  virtual void * data() const = 0;
+  virtual size_t length() const = 0;
+  virtual void resize(size_t length) = 0;
+
+  const char * format() const { return format_; }
+  size_t itemSize() const { return itemSize_; }
+private:
+  const char * format_;
+  size_t itemSize_;
+};
+
+#ifdef SCRIPT_RUBY
+// Is value a String with binary encoding (ASCII-8BIT), e.g. from Array#pack
+bool isRubyBinaryString(VALUE value);
+#endif
+
+// struct module format character of T
+template <typename T>
+const char * ScriptCppBufferFormat();
+template <> inline const char * ScriptCppBufferFormat<signed char>()
+  { return "b"; }
+template <> inline const char * ScriptCppBufferFormat<unsigned char>()
+  { return "B"; }
+template <> inline const char * ScriptCppBufferFormat<short>()
+  { return "h"; }
+template <> inline const char * ScriptCppBufferFormat<unsigned short>()
+  { return "H"; }
+template <> inline const char * ScriptCppBufferFormat<int>()
+  { return "i"; }
+template <> inline const char * ScriptCppBufferFormat<unsigned int>()
+  { return "I"; }
+template <> inline const char * ScriptCppBufferFormat<long>()
+  { return "l"; }
+template <> inline const char * ScriptCppBufferFormat<unsigned long>()
+  { return "L"; }
+template <> inline const char * ScriptCppBufferFormat<long long>()
+  { return "q"; }
+template <> inline const char * ScriptCppBufferFormat<unsigned long long>()
+  { return "Q"; }
+template <> inline const char * ScriptCppBufferFormat<float>()
+  { return "f"; }
+template <> inline const char * ScriptCppBufferFormat<double>()
+  { return "d"; }
+
+template <typename T>
+class ScriptCppBuffer : public ScriptCppBufferBase
+{
+public:
+  ScriptCppBuffer(std::vector<T> * cppArray)
+    : ScriptCppBufferBase(ScriptCppBufferFormat<T>(), sizeof(T)),
+      cppArray_(cppArray)
+    {}
+
+  virtual void * data() const override { return cppArray_->data(); }
+  virtual size_t length() const override { return cppArray_->size(); }
+  virtual void resize(size_t length) override { cppArray_->resize(length); }
+private:
+  std::vector<T> * cppArray_;
+};
+
+#endif
@@ -17,6 +17,12 @@
 
 #include "Singleton.h"
 #include "ReflectionImplement.h"
+#include "CallSiteCache.h"
+#include "ScriptStringCache.h"
+#include "ScriptReferencePool.h"
+#ifdef SCRIPT_RUBY
+#include "RubyRootTable.h"
+#endif
 #include <string>
 #include <vector>
 
@@ -56,86 +62,11 @@ public:
 
   // Call a global function in Ruby.
   //
-  // Puting return value as argument, so template deduction works
-  template <typename R>
-  void callRuby(const std::string & functionName,
-                R & returnValue) const;
-  template <typename R, typename A1>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                R & returnValue) const;
-  template <typename R, typename A1, typename A2>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3, typename A4>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                const A4 & a4,
-                R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3, typename A4,
-            typename A5>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                const A4 & a4,
-                const A5 & a5,
-                R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3, typename A4,
-            typename A5, typename A6>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                const A4 & a4,
-                const A5 & a5,
-                const A6 & a6,
-                R & returnValue) const;
-  void callRuby(const std::string & functionName) const;
-  template <typename A1>
-  void callRuby(const std::string & functionName,
-                const A1 & a1) const;
-  template <typename A1, typename A2>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2) const;
-  template <typename A1, typename A2, typename A3>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3) const;
-  template <typename A1, typename A2, typename A3, typename A4>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                const A4 & a4) const;
-  template <typename A1, typename A2, typename A3, typename A4, typename A5>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                const A4 & a4,
-                const A5 & a5) const;
-  template <typename A1, typename A2, typename A3, typename A4, typename A5,
-            typename A6>
-  void callRuby(const std::string & functionName,
-                const A1 & a1,
-                const A2 & a2,
-                const A3 & a3,
-                const A4 & a4,
-                const A5 & a5,
-                const A6 & a6) const;
+  // callRuby("f", a1, a2) calls f(a1, a2).  When the last argument is a
+  // non-const lvalue it receives the return value instead, so
+  // callRuby("f", a1, result) does result = f(a1).
+  template <typename... Args>
+  void callRuby(const std::string & functionName, Args && ... args) const;
 #endif
 #ifdef SCRIPT_PYTHON
   // Run a python script.
@@ -148,99 +79,12 @@ public:
   void runPythonString(const std::string & code);
   void addPythonScriptPath(const std::string & path);
 
-  template <typename R>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  R & returnValue) const;
-  template <typename R, typename A1>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  R & returnValue) const;
-  template <typename R, typename A1, typename A2>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3, typename A4>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  const A4 & a4,
-                  R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3, typename A4,
-            typename A5>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  const A4 & a4,
-                  const A5 & a5,
-                  R & returnValue) const;
-  template <typename R, typename A1, typename A2, typename A3, typename A4,
-            typename A5, typename A6>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  const A4 & a4,
-                  const A5 & a5,
-                  const A6 & a6,
-                  R & returnValue) const;
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName) const;
-  template <typename A1>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1) const;
-  template <typename A1, typename A2>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2) const;
-  template <typename A1, typename A2, typename A3>
+  // Call a function of a module returned by runPythonScript.  Arguments and
+  // return value as in callRuby.
+  template <typename... Args>
   void callPython(ReflectionHandle pythonModule,
                   const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3) const;
-  template <typename A1, typename A2, typename A3, typename A4>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  const A4 & a4) const;
-  template <typename A1, typename A2, typename A3, typename A4, typename A5>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  const A4 & a4,
-                  const A5 & a5) const;
-  template <typename A1, typename A2, typename A3, typename A4, typename A5,
-            typename A6>
-  void callPython(ReflectionHandle pythonModule,
-                  const std::string & functionName,
-                  const A1 & a1,
-                  const A2 & a2,
-                  const A3 & a3,
-                  const A4 & a4,
-                  const A5 & a5,
-                  const A6 & a6) const;
+                  Args && ... args) const;
 #endif
 
   // Treat the \arg scriptType (in C++ typeid().name style) equal to \arg
@@ -252,6 +96,23 @@ public:
   // your custom class.
   void addTypeEquality(const std::string & scriptType, const std::string & cppType);
 
+  // Hit/miss counters of the overload resolution caches of all exported
+  // methods, constructors and global functions.
+  // A call is counted as uncacheable when its arguments can't be summarized
+  // cheaply (e.g. nested arrays), those always do a full signature match.
+  const CallSiteCacheStatistics & getCallSiteCacheStatistics() const;
+  void resetCallSiteCacheStatistics();
+
+  // Hit/miss counters of the cache of strings returned by exports with the
+  // Reflection::intern_strings policy.
+  const ScriptStringCacheStatistics & getStringCacheStatistics() const;
+  void resetStringCacheStatistics();
+  // Maximum number of cached strings per language (default 4096)
+  void setStringCacheCapacity(size_t capacity);
+
+  // Occupancy of the pool allocating the references of exported objects
+  const ScriptReferencePoolStatistics & getReferencePoolStatistics() const;
+
 private:
   class Anonymous; // friend in anonymous namespace trick : holds functions
                    // which should have access to our private members
@@ -268,7 +129,7 @@ private:
                             void * data);
   Reflection::MethodBase *
     getGlobalFunction(const std::string & name,
-                      const std::vector<std::string> & signature) const;
+                      const Reflection::Signature & signature) const;
 
   typedef std::unordered_multimap<std::string, Reflection::MethodBase*>
     GlobalFunctionMap;
@@ -278,35 +139,21 @@ private:
   void registerRubyObject(VALUE object);
   void unregisterRubyObject(VALUE object);
   VALUE callRubyPrivate(const std::string & functionName,
-                        VALUE argument1=0,
-                        VALUE argument2=0,
-                        VALUE argument3=0,
-                        VALUE argument4=0,
-                        VALUE argument5=0,
-                        VALUE argument6=0) const;
+                        unsigned int argc,
+                        const ReflectionHandle * argv) const;
 
   VALUE rbmodule_;
-  // All ruby objects which have a counterpart in C
-  // This is needed for garbage collection to work.
-  // The mark based thing doesn't seem to work.  It is only for VALUE member of
-  // a C wrapped struct.  You still need some method to 'mark' the C wrapper
-  // struct itself.
-  // We could use rb_gc_register_address but some people say it is not as
-  // efficient as a hash (especially to find and delete elements from it)
-  // The hash contains all ruby VALUEs for all C++ objects which have usedInC_
-  // set to true, i.e. objects that are also used in C++.
-  VALUE rbObjectHash_;
+  // All ruby objects which have a counterpart in C, i.e. objects that are
+  // also used in C++ (usedInC_ set to true).  They are marked from here so
+  // ruby GC doesn't collect them.
+  RubyRootTable rbRoots_;
 #endif
 #ifdef SCRIPT_PYTHON
   PyObject * pymodule_;
   PyObject * callPythonPrivate(PyObject * pythonModule,
                                const std::string & functionName,
-                               PyObject * argument1=0,
-                               PyObject * argument2=0,
-                               PyObject * argument3=0,
-                               PyObject * argument4=0,
-                               PyObject * argument5=0,
-                               PyObject * argument6=0) const;
+                               unsigned int argc,
+                               const ReflectionHandle * argv) const;
 #endif
 };
 
@@ -365,506 +212,32 @@ void ScriptInterface::makeGlobalConstant(const std::string & name,
 }
 
 #ifdef SCRIPT_RUBY
-template <typename R>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               R & returnValue) const
-{
-  ReflectionHandle rubyResult;
-  rubyResult.rubyHandle = callRubyPrivate(functionName);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename R, typename A1>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               R & returnValue) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyResult;
-  rubyResult.rubyHandle =
-    callRubyPrivate(functionName, rubyArgument1.rubyHandle);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename R, typename A1, typename A2>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               R & returnValue) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyResult;
-  rubyResult.rubyHandle =
-    callRubyPrivate(functionName,
-                    rubyArgument1.rubyHandle,
-                    rubyArgument2.rubyHandle);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename R, typename A1, typename A2, typename A3>
+template <typename... Args>
 void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               R & returnValue) const
+                               Args && ... args) const
 {
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
+  ScriptCall<Args...> call(LANGUAGE_RUBY, args...);
   ReflectionHandle rubyResult;
-  rubyResult.rubyHandle =
-    callRubyPrivate(functionName,
-                    rubyArgument1.rubyHandle,
-                    rubyArgument2.rubyHandle,
-                    rubyArgument3.rubyHandle);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename R, typename A1, typename A2, typename A3, typename A4>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               const A4 & a4,
-                               R & returnValue) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument4 = ReflectionRead(a4, LANGUAGE_RUBY);
-  ReflectionHandle rubyResult;
-  rubyResult.rubyHandle =
-    callRubyPrivate(functionName,
-                    rubyArgument1.rubyHandle,
-                    rubyArgument2.rubyHandle,
-                    rubyArgument3.rubyHandle,
-                    rubyArgument4.rubyHandle);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename R, typename A1, typename A2, typename A3, typename A4,
-          typename A5>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               const A4 & a4,
-                               const A5 & a5,
-                               R & returnValue) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument4 = ReflectionRead(a4, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument5 = ReflectionRead(a5, LANGUAGE_RUBY);
-  ReflectionHandle rubyResult;
-  rubyResult.rubyHandle =
-    callRubyPrivate(functionName,
-                    rubyArgument1.rubyHandle,
-                    rubyArgument2.rubyHandle,
-                    rubyArgument3.rubyHandle,
-                    rubyArgument4.rubyHandle,
-                    rubyArgument5.rubyHandle);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename R, typename A1, typename A2, typename A3, typename A4,
-          typename A5, typename A6>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               const A4 & a4,
-                               const A5 & a5,
-                               const A6 & a6,
-                               R & returnValue) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument4 = ReflectionRead(a4, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument5 = ReflectionRead(a5, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument6 = ReflectionRead(a6, LANGUAGE_RUBY);
-  ReflectionHandle rubyResult;
-  rubyResult.rubyHandle =
-    callRubyPrivate(functionName,
-                    rubyArgument1.rubyHandle,
-                    rubyArgument2.rubyHandle,
-                    rubyArgument3.rubyHandle,
-                    rubyArgument4.rubyHandle,
-                    rubyArgument5.rubyHandle,
-                    rubyArgument6.rubyHandle);
-  ReflectionWrite(rubyResult, returnValue, LANGUAGE_RUBY);
-}
-
-template <typename A1>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  callRubyPrivate(functionName, rubyArgument1.rubyHandle);
-}
-
-template <typename A1, typename A2>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  callRubyPrivate(functionName,
-                  rubyArgument1.rubyHandle,
-                  rubyArgument2.rubyHandle);
-}
-
-template <typename A1, typename A2, typename A3>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  callRubyPrivate(functionName,
-                  rubyArgument1.rubyHandle,
-                  rubyArgument2.rubyHandle,
-                  rubyArgument3.rubyHandle);
-}
-
-template <typename A1, typename A2, typename A3, typename A4>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               const A4 & a4) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument4 = ReflectionRead(a4, LANGUAGE_RUBY);
-  callRubyPrivate(functionName,
-                  rubyArgument1.rubyHandle,
-                  rubyArgument2.rubyHandle,
-                  rubyArgument3.rubyHandle,
-                  rubyArgument4.rubyHandle);
-}
-
-template <typename A1, typename A2, typename A3, typename A4, typename A5>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               const A4 & a4,
-                               const A5 & a5) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument4 = ReflectionRead(a4, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument5 = ReflectionRead(a5, LANGUAGE_RUBY);
-  callRubyPrivate(functionName,
-                  rubyArgument1.rubyHandle,
-                  rubyArgument2.rubyHandle,
-                  rubyArgument3.rubyHandle,
-                  rubyArgument4.rubyHandle,
-                  rubyArgument5.rubyHandle);
-}
-
-template <typename A1, typename A2, typename A3, typename A4, typename A5,
-          typename A6>
-void ScriptInterface::callRuby(const std::string & functionName,
-                               const A1 & a1,
-                               const A2 & a2,
-                               const A3 & a3,
-                               const A4 & a4,
-                               const A5 & a5,
-                               const A6 & a6) const
-{
-  ReflectionHandle rubyArgument1 = ReflectionRead(a1, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument2 = ReflectionRead(a2, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument3 = ReflectionRead(a3, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument4 = ReflectionRead(a4, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument5 = ReflectionRead(a5, LANGUAGE_RUBY);
-  ReflectionHandle rubyArgument6 = ReflectionRead(a6, LANGUAGE_RUBY);
-  callRubyPrivate(functionName,
-                  rubyArgument1.rubyHandle,
-                  rubyArgument2.rubyHandle,
-                  rubyArgument3.rubyHandle,
-                  rubyArgument4.rubyHandle,
-                  rubyArgument5.rubyHandle,
-                  rubyArgument6.rubyHandle);
+  rubyResult.rubyHandle = callRubyPrivate(functionName,
+                                          call.numArguments, call.handles());
+  call.writeResult(rubyResult, LANGUAGE_RUBY);
 }
 #endif
 
 #ifdef SCRIPT_PYTHON
-template <typename R>
+template <typename... Args>
 void ScriptInterface::callPython(ReflectionHandle pythonModule,
                                  const std::string & functionName,
-                                 R & returnValue) const
+                                 Args && ... args) const
 {
-  ReflectionHandle pyResult;
-  pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
-                                            functionName);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
-  Py_XDECREF(pyResult.pythonHandle);
-}
-
-template <typename R, typename A1>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 R & returnValue) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyResult;
-  pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
-                                            functionName,
-                                            pyArgument1.pythonHandle);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
-  Py_XDECREF(pyResult.pythonHandle);
-}
-
-template <typename R, typename A1, typename A2>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 R & returnValue) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyResult;
-  pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
-                                            functionName,
-                                            pyArgument1.pythonHandle,
-                                            pyArgument2.pythonHandle);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
-  Py_XDECREF(pyResult.pythonHandle);
-}
-
-template <typename R, typename A1, typename A2, typename A3>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 R & returnValue) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
+  ScriptCall<Args...> call(LANGUAGE_PYTHON, args...);
   ReflectionHandle pyResult;
   pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
                                             functionName,
-                                            pyArgument1.pythonHandle,
-                                            pyArgument2.pythonHandle,
-                                            pyArgument3.pythonHandle);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
+                                            call.numArguments, call.handles());
+  call.writeResult(pyResult, LANGUAGE_PYTHON);
   Py_XDECREF(pyResult.pythonHandle);
 }
-
-template <typename R, typename A1, typename A2, typename A3, typename A4>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 const A4 & a4,
-                                 R & returnValue) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument4 = ReflectionRead(a4, LANGUAGE_PYTHON);
-  ReflectionHandle pyResult;
-  pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
-                                            functionName,
-                                            pyArgument1.pythonHandle,
-                                            pyArgument2.pythonHandle,
-                                            pyArgument3.pythonHandle,
-                                            pyArgument4.pythonHandle);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
-  Py_XDECREF(pyResult.pythonHandle);
-}
-
-template <typename R, typename A1, typename A2, typename A3, typename A4,
-          typename A5>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 const A4 & a4,
-                                 const A5 & a5,
-                                 R & returnValue) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument4 = ReflectionRead(a4, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument5 = ReflectionRead(a5, LANGUAGE_PYTHON);
-  ReflectionHandle pyResult;
-  pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
-                                            functionName,
-                                            pyArgument1.pythonHandle,
-                                            pyArgument2.pythonHandle,
-                                            pyArgument3.pythonHandle,
-                                            pyArgument4.pythonHandle,
-                                            pyArgument5.pythonHandle);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
-  Py_XDECREF(pyResult.pythonHandle);
-}
-
-template <typename R, typename A1, typename A2, typename A3, typename A4,
-          typename A5, typename A6>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 const A4 & a4,
-                                 const A5 & a5,
-                                 const A6 & a6,
-                                 R & returnValue) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument4 = ReflectionRead(a4, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument5 = ReflectionRead(a5, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument6 = ReflectionRead(a6, LANGUAGE_PYTHON);
-  ReflectionHandle pyResult;
-  pyResult.pythonHandle = callPythonPrivate(pythonModule.pythonHandle,
-                                            functionName,
-                                            pyArgument1.pythonHandle,
-                                            pyArgument2.pythonHandle,
-                                            pyArgument3.pythonHandle,
-                                            pyArgument4.pythonHandle,
-                                            pyArgument5.pythonHandle,
-                                            pyArgument6.pythonHandle);
-  ReflectionWrite(pyResult, returnValue, LANGUAGE_PYTHON);
-  Py_XDECREF(pyResult.pythonHandle);
-}
-
-template <typename A1>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  PyObject * result = callPythonPrivate(pythonModule.pythonHandle,
-                                        functionName,
-                                        pyArgument1.pythonHandle);
-  Py_XDECREF(result);
-}
-
-template <typename A1, typename A2>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  PyObject * result = callPythonPrivate(pythonModule.pythonHandle,
-                                        functionName,
-                                        pyArgument1.pythonHandle,
-                                        pyArgument2.pythonHandle);
-  Py_XDECREF(result);
-}
-
-template <typename A1, typename A2, typename A3>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  PyObject * result = callPythonPrivate(pythonModule.pythonHandle,
-                                        functionName,
-                                        pyArgument1.pythonHandle,
-                                        pyArgument2.pythonHandle,
-                                        pyArgument3.pythonHandle);
-  Py_XDECREF(result);
-}
-
-template <typename A1, typename A2, typename A3, typename A4>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 const A4 & a4) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument4 = ReflectionRead(a4, LANGUAGE_PYTHON);
-  PyObject * result = callPythonPrivate(pythonModule.pythonHandle,
-                                        functionName,
-                                        pyArgument1.pythonHandle,
-                                        pyArgument2.pythonHandle,
-                                        pyArgument3.pythonHandle,
-                                        pyArgument4.pythonHandle);
-  Py_XDECREF(result);
-}
-
-template <typename A1, typename A2, typename A3, typename A4, typename A5>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 const A4 & a4,
-                                 const A5 & a5) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument4 = ReflectionRead(a4, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument5 = ReflectionRead(a5, LANGUAGE_PYTHON);
-  PyObject * result = callPythonPrivate(pythonModule.pythonHandle,
-                                        functionName,
-                                        pyArgument1.pythonHandle,
-                                        pyArgument2.pythonHandle,
-                                        pyArgument3.pythonHandle,
-                                        pyArgument4.pythonHandle,
-                                        pyArgument5.pythonHandle);
-  Py_XDECREF(result);
-}
-
-template <typename A1, typename A2, typename A3, typename A4, typename A5,
-          typename A6>
-void ScriptInterface::callPython(ReflectionHandle pythonModule,
-                                 const std::string & functionName,
-                                 const A1 & a1,
-                                 const A2 & a2,
-                                 const A3 & a3,
-                                 const A4 & a4,
-                                 const A5 & a5,
-                                 const A6 & a6) const
-{
-  ReflectionHandle pyArgument1 = ReflectionRead(a1, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument2 = ReflectionRead(a2, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument3 = ReflectionRead(a3, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument4 = ReflectionRead(a4, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument5 = ReflectionRead(a5, LANGUAGE_PYTHON);
-  ReflectionHandle pyArgument6 = ReflectionRead(a6, LANGUAGE_PYTHON);
-  PyObject * result = callPythonPrivate(pythonModule.pythonHandle,
-                                        functionName,
-                                        pyArgument1.pythonHandle,
-                                        pyArgument2.pythonHandle,
-                                        pyArgument3.pythonHandle,
-                                        pyArgument4.pythonHandle,
-                                        pyArgument5.pythonHandle,
-                                        pyArgument6.pythonHandle);
-  Py_XDECREF(result);
-}
 #endif
 
 #endif
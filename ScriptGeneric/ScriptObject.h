@@ -25,6 +25,14 @@
 #include <string>
 #include <vector>
 
+union ReflectionHandle;
+
+// Python's cyclic GC only sees the ScriptObjects an exported class reports
+// with a member
+//   template <typename Visit> void visitScriptObjects(Visit visit)
+//     { visit(callback_); }
+// Visit takes a ScriptObject &.  Without it a cycle through a ScriptObject,
+// e.g. a python callback bound to the object storing it, is never collected.
 class ScriptObject
 {
 public:
@@ -54,61 +62,11 @@ public:
   /// Python : it has a __call__ method
   ///
   /// If functionName is not empty, call the specified function
-  template <typename R>
-  void call(const std::string & functionName,
-            R & result) const;
-  template <typename T1, typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            R & result) const;
-  template <typename T1, typename T2, typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            const T2 & argument2,
-            R & result) const;
-  template <typename T1, typename T2, typename T3, typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            const T2 & argument2,
-            const T3 & argument3,
-            R & result) const;
-  template <typename T1, typename T2, typename T3, typename T4, typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            const T2 & argument2,
-            const T3 & argument3,
-            const T4 & argument4,
-            R & result) const;
-  template <typename T1, typename T2, typename T3, typename T4, typename T5,
-            typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            const T2 & argument2,
-            const T3 & argument3,
-            const T4 & argument4,
-            const T5 & argument5,
-            R & result) const;
-  template <typename T1, typename T2, typename T3, typename T4, typename T5,
-            typename T6, typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            const T2 & argument2,
-            const T3 & argument3,
-            const T4 & argument4,
-            const T5 & argument5,
-            const T6 & argument6,
-            R & result) const;
-  template <typename T1, typename T2, typename T3, typename T4, typename T5,
-            typename T6, typename T7, typename R>
-  void call(const std::string & functionName,
-            const T1 & argument1,
-            const T2 & argument2,
-            const T3 & argument3,
-            const T4 & argument4,
-            const T5 & argument5,
-            const T6 & argument6,
-            const T7 & argument7,
-            R & result) const;
+  ///
+  /// The last argument receives the return value when it is a non-const
+  /// lvalue, e.g. call("f", a1, result) does result = f(a1).
+  template <typename... Args>
+  void call(const std::string & functionName, Args && ... args) const;
 
   template <typename T>
   void setAttr(const std::string & name, const T & value);
@@ -124,32 +82,27 @@ public:
   PyObject * getPyObject() const { return pyObject_; }
   void setPyObject(PyObject * pyObject);
   static std::string getPythonClassname(PyObject * pyObject);
+
+  // Cyclic GC support for the python object owning the C++ object holding
+  // this ScriptObject.  Handles that share their reference with a copy
+  // elsewhere are left alone.  clearPython empties this ScriptObject and
+  // returns the python object to release, or nullptr.
+  int traversePython(visitproc visit, void * arg) const;
+  PyObject * clearPython();
 #endif
 
 private:
 #ifdef SCRIPT_RUBY
-  void call(const std::string & functionName,
-            VALUE & result,
-            VALUE argument1=0,
-            VALUE argument2=0,
-            VALUE argument3=0,
-            VALUE argument4=0,
-            VALUE argument5=0,
-            VALUE argument6=0,
-            VALUE argument7=0) const;
+  VALUE callRuby(const std::string & functionName,
+                 unsigned int argc, const ReflectionHandle * argv) const;
 
   VALUE rubyValue_;
 #endif
 #ifdef SCRIPT_PYTHON
-  void call(const std::string & functionName,
-            PyObject * & result,
-            PyObject * argument1=0,
-            PyObject * argument2=0,
-            PyObject * argument3=0,
-            PyObject * argument4=0,
-            PyObject * argument5=0,
-            PyObject * argument6=0,
-            PyObject * argument7=0) const;
+  PyObject * callPython(const std::string & functionName,
+                        unsigned int argc,
+                        const ReflectionHandle * argv) const;
+
   PyObject * pyObject_;
 #endif
   void * language_;  // LANGUAGE_RUBY or LANGUAGE_PYTHON, set in constructor
@@ -158,301 +111,32 @@ private:
 
 #include "ReflectionImplement.h"
 
-template <typename R>
-void ScriptObject::call(const std::string & functionName,
-                      R & result) const
-{
-  ReflectionHandle rubyResult;
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle);
-#endif
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle);
-#endif
-  try
-    {
-      ReflectionWrite(rubyResult, result, language_);
-    }
-  catch (std::exception & e)
-    {
-      throw std::runtime_error("When converting return value for script "
-                               "function " + classname() + "::" + functionName +
-                               " :\n" + e.what());
-    }
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T, typename R>
-void ScriptObject::call(const std::string & functionName, const T & argument1,
-                       R & result) const
-{
-  ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle);
-#endif
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle);
-#endif
-  try
-    {
-      ReflectionWrite(rubyResult, result, language_);
-    }
-  catch (std::exception & e)
-    {
-      throw std::runtime_error("When converting return value for script "
-                               "function " + classname() + "::" + functionName +
-                               " :\n" + e.what());
-    }
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T1, typename T2, typename R>
+template <typename... Args>
 void ScriptObject::call(const std::string & functionName,
-                      const T1 & argument1,
-                      const T2 & argument2,
-                      R & result) const
+                        Args && ... args) const
 {
+  ScriptCall<Args...> call(language_, args...);
   ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-  ReflectionHandle rubyArgument2 = ReflectionRead(argument2, language_);
 #ifdef SCRIPT_RUBY
   if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle,
-         rubyArgument2.rubyHandle);
+    rubyResult.rubyHandle =
+      callRuby(functionName, call.numArguments, call.handles());
 #endif
 #ifdef SCRIPT_PYTHON
   if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle,
-         rubyArgument2.pythonHandle);
+    rubyResult.pythonHandle =
+      callPython(functionName, call.numArguments, call.handles());
 #endif
   try
     {
-      ReflectionWrite(rubyResult, result, language_);
+      call.writeResult(rubyResult, language_);
     }
   catch (std::exception & e)
     {
-      throw std::runtime_error("When converting return value for script "
-                               "function " + classname() + "::" + functionName +
-                               " :\n" + e.what());
-    }
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T1, typename T2, typename T3, typename R>
-void ScriptObject::call(const std::string & functionName,
-                      const T1 & argument1,
-                      const T2 & argument2,
-                      const T3 & argument3,
-                      R & result) const
-{
-  ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-  ReflectionHandle rubyArgument2 = ReflectionRead(argument2, language_);
-  ReflectionHandle rubyArgument3 = ReflectionRead(argument3, language_);
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle,
-         rubyArgument2.rubyHandle, rubyArgument3.rubyHandle);
-#endif
 #ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle,
-         rubyArgument2.pythonHandle, rubyArgument3.pythonHandle);
-#endif
-  ReflectionWrite(rubyResult, result, language_);
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T1, typename T2, typename T3, typename T4, typename R>
-void ScriptObject::call(const std::string & functionName,
-                      const T1 & argument1,
-                      const T2 & argument2,
-                      const T3 & argument3,
-                      const T4 & argument4,
-                      R & result) const
-{
-  ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-  ReflectionHandle rubyArgument2 = ReflectionRead(argument2, language_);
-  ReflectionHandle rubyArgument3 = ReflectionRead(argument3, language_);
-  ReflectionHandle rubyArgument4 = ReflectionRead(argument4, language_);
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle,
-         rubyArgument2.rubyHandle, rubyArgument3.rubyHandle,
-         rubyArgument4.rubyHandle);
+      if (pyObject_)
+        Py_DECREF(rubyResult.pythonHandle);
 #endif
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle,
-         rubyArgument2.pythonHandle, rubyArgument3.pythonHandle,
-         rubyArgument4.pythonHandle);
-#endif
-  try
-    {
-      ReflectionWrite(rubyResult, result, language_);
-    }
-  catch (std::exception & e)
-    {
-      throw std::runtime_error("When converting return value for script "
-                               "function " + classname() + "::" + functionName +
-                               " :\n" + e.what());
-    }
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T1, typename T2, typename T3, typename T4, typename T5,
-          typename R>
-void ScriptObject::call(const std::string & functionName,
-                      const T1 & argument1,
-                      const T2 & argument2,
-                      const T3 & argument3,
-                      const T4 & argument4,
-                      const T5 & argument5,
-                      R & result) const
-{
-  ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-  ReflectionHandle rubyArgument2 = ReflectionRead(argument2, language_);
-  ReflectionHandle rubyArgument3 = ReflectionRead(argument3, language_);
-  ReflectionHandle rubyArgument4 = ReflectionRead(argument4, language_);
-  ReflectionHandle rubyArgument5 = ReflectionRead(argument5, language_);
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle,
-         rubyArgument2.rubyHandle, rubyArgument3.rubyHandle,
-         rubyArgument4.rubyHandle, rubyArgument5.rubyHandle);
-#endif
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle,
-         rubyArgument2.pythonHandle, rubyArgument3.pythonHandle,
-         rubyArgument4.pythonHandle, rubyArgument5.pythonHandle);
-#endif
-  try
-    {
-      ReflectionWrite(rubyResult, result, language_);
-    }
-  catch (std::exception & e)
-    {
-      throw std::runtime_error("When converting return value for script "
-                               "function " + classname() + "::" + functionName +
-                               " :\n" + e.what());
-    }
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T1, typename T2, typename T3, typename T4, typename T5,
-          typename T6, typename R>
-void ScriptObject::call(const std::string & functionName,
-                      const T1 & argument1,
-                      const T2 & argument2,
-                      const T3 & argument3,
-                      const T4 & argument4,
-                      const T5 & argument5,
-                      const T6 & argument6,
-                      R & result) const
-{
-  ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-  ReflectionHandle rubyArgument2 = ReflectionRead(argument2, language_);
-  ReflectionHandle rubyArgument3 = ReflectionRead(argument3, language_);
-  ReflectionHandle rubyArgument4 = ReflectionRead(argument4, language_);
-  ReflectionHandle rubyArgument5 = ReflectionRead(argument5, language_);
-  ReflectionHandle rubyArgument6 = ReflectionRead(argument6, language_);
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle,
-         rubyArgument2.rubyHandle, rubyArgument3.rubyHandle,
-         rubyArgument4.rubyHandle, rubyArgument5.rubyHandle,
-         rubyArgument6.rubyHandle);
-#endif
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle,
-         rubyArgument2.pythonHandle, rubyArgument3.pythonHandle,
-         rubyArgument4.pythonHandle, rubyArgument5.pythonHandle,
-         rubyArgument6.pythonHandle);
-#endif
-  try
-    {
-      ReflectionWrite(rubyResult, result, language_);
-    }
-  catch (std::exception & e)
-    {
-      throw std::runtime_error("When converting return value for script "
-                               "function " + classname() + "::" + functionName +
-                               " :\n" + e.what());
-    }
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    Py_DECREF(rubyResult.pythonHandle);
-#endif
-}
-
-template <typename T1, typename T2, typename T3, typename T4, typename T5,
-          typename T6, typename T7, typename R>
-void ScriptObject::call(const std::string & functionName,
-                      const T1 & argument1,
-                      const T2 & argument2,
-                      const T3 & argument3,
-                      const T4 & argument4,
-                      const T5 & argument5,
-                      const T6 & argument6,
-                      const T7 & argument7,
-                      R & result) const
-{
-  ReflectionHandle rubyResult;
-  ReflectionHandle rubyArgument1 = ReflectionRead(argument1, language_);
-  ReflectionHandle rubyArgument2 = ReflectionRead(argument2, language_);
-  ReflectionHandle rubyArgument3 = ReflectionRead(argument3, language_);
-  ReflectionHandle rubyArgument4 = ReflectionRead(argument4, language_);
-  ReflectionHandle rubyArgument5 = ReflectionRead(argument5, language_);
-  ReflectionHandle rubyArgument6 = ReflectionRead(argument6, language_);
-  ReflectionHandle rubyArgument7 = ReflectionRead(argument7, language_);
-#ifdef SCRIPT_RUBY
-  if (rubyValue_)
-    call(functionName, rubyResult.rubyHandle, rubyArgument1.rubyHandle,
-         rubyArgument2.rubyHandle, rubyArgument3.rubyHandle,
-         rubyArgument4.rubyHandle, rubyArgument5.rubyHandle,
-         rubyArgument6.rubyHandle, rubyArgument7.rubyHandle);
-#endif
-#ifdef SCRIPT_PYTHON
-  if (pyObject_)
-    call(functionName, rubyResult.pythonHandle, rubyArgument1.pythonHandle,
-         rubyArgument2.pythonHandle, rubyArgument3.pythonHandle,
-         rubyArgument4.pythonHandle, rubyArgument5.pythonHandle,
-         rubyArgument6.pythonHandle, rubyArgument7.pythonHandle);
-#endif
-  try
-    {
-      ReflectionWrite(rubyResult, result, language_);
-    }
-  catch (std::exception & e)
-    {
       throw std::runtime_error("When converting return value for script "
                                "function " + classname() + "::" + functionName +
                                " :\n" + e.what());
@@ -35,6 +35,13 @@ public:
   bool isUsedInC() const { return usedInC_ != 0; }
 
   AbstractPointer * getCppObject() const;
+  // The C++ object, same as getCppObject()->get() without the virtual call
+  void * getObject() const { return object_; }
+  // Give up ownership of the C++ object, see AbstractPointer::release
+  virtual void * releaseCppObject();
+  // The C++ object was destroyed while the script still refers to it, e.g.
+  // a borrowed member of another object.  Called by ~ScriptAccess.
+  virtual void forgetCppObject();
 
 protected:
   // delete not allowed, you should call deleteFromC(), that will call delete
@@ -42,6 +49,7 @@ protected:
   virtual ~ScriptReference() {}
 
   AbstractPointer * cppObject_;
+  void * object_;
   // For ruby this is equal to VALUE being stored in the rubyHash_
   // For python this is equal to the pyObject being Py_INCREF'd
   // And it is a reference count, i.e. how many times it has been (stored in
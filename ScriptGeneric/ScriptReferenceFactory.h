@@ -17,27 +17,33 @@
 
 #include "Singleton.h"
 #include "ConcretePointer.h"
-#include <typeinfo>
-
-class ScriptReference;
+#include "RubyPythonReference.h"
 
 class ScriptReferenceFactory : public Singleton<ScriptReferenceFactory>
 {
 public:
+  // A borrowed cppObject is not deleted with the reference
   template<typename T> ScriptReference * make(T * cppObject,
-                                              bool fromSharedPtr);
-
-private:
-  ScriptReference * makeGeneric(AbstractPointer * cppObject,
-                                const char * typeid_name);
+                                              bool fromSharedPtr,
+                                              bool borrowed = false);
+  template<typename T> ScriptReference * make(std::shared_ptr<T> cppObject);
 };
 
 template<typename T>
 ScriptReference * ScriptReferenceFactory::make(T * cppObject,
-                                               bool fromSharedPtr)
+                                               bool fromSharedPtr,
+                                               bool borrowed)
+{
+  return RubyPythonReference::create<ConcretePointer<T> >(cppObject,
+                                                          fromSharedPtr,
+                                                          borrowed);
+}
+
+template<typename T>
+ScriptReference *
+ScriptReferenceFactory::make(std::shared_ptr<T> cppObject)
 {
-  return makeGeneric(new ConcretePointer<T>(cppObject, fromSharedPtr),
-                     typeid(T).name());
+  return RubyPythonReference::create<ConcretePointer<T> >(std::move(cppObject));
 }
 
 #endif
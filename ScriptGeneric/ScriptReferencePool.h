@@ -0,0 +1,48 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ScriptReferencePool_h_
+#define ScriptReferencePool_h_
+
+#include <cstddef>
+
+struct ScriptReferencePoolStatistics
+{
+  unsigned long long slabs;       // slabs allocated, they are never freed
+  unsigned long long blocksInUse;
+  unsigned long long blocksFree;  // free blocks in the slabs
+  unsigned long long largeBlocks; // too big for a slab, from operator new
+};
+
+// Allocator for the memory block holding a RubyPythonReference and its
+// ConcretePointer.  Blocks are rounded up to a size class (a multiple of
+// 16 bytes), each size class hands out blocks from slabs of 64 KiB and
+// keeps freed blocks in a free list.
+// Like the rest of the script interface this is not thread safe, it is only
+// used while holding the interpreter lock.
+class ScriptReferencePool
+{
+public:
+  static void * allocate(size_t size);
+  // size must be the size given to allocate
+  static void deallocate(void * block, size_t size);
+
+  static const ScriptReferencePoolStatistics & statistics()
+    { return statistics_; }
+
+private:
+  static ScriptReferencePoolStatistics statistics_;
+};
+
+#endif
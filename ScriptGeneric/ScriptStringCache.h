@@ -0,0 +1,54 @@
+// This file is part of rubyexport.
+//
+// rubyexport is free software: you can redistribute it and/or modify it under
+// the terms of the GNU General Public License as published by the Free Software
+// Foundation, either version 3 of the License, or (at your option) any later
+// version.
+//
+// rubyexport is distributed in the hope that it will be useful, but WITHOUT ANY
+// WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+// PARTICULAR PURPOSE. See the GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License along with
+// rubyexport. If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef ScriptStringCache_h_
+#define ScriptStringCache_h_
+
+#include "ReflectionImplement.h"
+#include <cstddef>
+#include <string>
+
+struct ScriptStringCacheStatistics
+{
+  unsigned long long hits;
+  unsigned long long misses;
+  unsigned long long entries;
+};
+
+// Script strings for std::string values that are returned over and over,
+// e.g. names, keys and status codes.  Exports with the
+// Reflection::intern_strings policy get the same frozen ruby string or
+// interned python str for a value seen before, instead of a new string on
+// every call.
+// The cache is bounded : once it holds capacity() strings per language, new
+// values are converted as usual (and counted as misses).
+class ScriptStringCache
+{
+public:
+  static ReflectionHandle read(const std::string & value, void * data);
+
+  static const ScriptStringCacheStatistics & statistics()
+    { return statistics_; }
+  static void resetStatistics();
+  static size_t capacity() { return capacity_; }
+  static void setCapacity(size_t capacity);
+  // Forget all cached strings
+  static void clear();
+
+private:
+  static ScriptStringCacheStatistics statistics_;
+  static size_t capacity_;
+};
+
+#endif